@@ -0,0 +1,185 @@
+#include "AsyncDatabase.h"
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QDebug>
+
+AsyncDatabase::AsyncDatabase(const QString &databasePath, const std::shared_ptr<QueryStats> &queryStats,
+                             QObject *parent)
+    : QThread(parent), databasePath(databasePath), queryStats(queryStats), stopping(false), openFinished(false),
+      openSucceeded(false)
+{
+    // Each instance needs its own connection name
+    static QAtomicInt nextInstance;
+    connectionName = QString("async_%1").arg(nextInstance.fetchAndAddRelaxed(1));
+}
+
+AsyncDatabase::~AsyncDatabase()
+{
+    stop();
+}
+
+bool AsyncDatabase::open()
+{
+    start();
+
+    QMutexLocker locker(&mutex);
+    while (!openFinished)
+    {
+        openChanged.wait(&mutex);
+    }
+
+    return openSucceeded;
+}
+
+void AsyncDatabase::stop()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        queueChanged.wakeAll();
+    }
+
+    wait();
+}
+
+QFuture<bool> AsyncDatabase::write(std::function<bool(Database &)> job, int tournamentId)
+{
+    auto promise = std::make_shared<QPromise<bool>>();
+    promise->start();
+    QFuture<bool> future = promise->future();
+
+    Task task;
+    task.isWrite = true;
+    task.tournamentId = tournamentId;
+    task.run = job;
+    task.complete = [promise](bool ok)
+    {
+        promise->addResult(ok);
+        promise->finish();
+    };
+    enqueue(task);
+
+    return future;
+}
+
+QFuture<bool> AsyncDatabase::submitResult(int tournamentId, int matchId, const QString &result)
+{
+    return write([tournamentId, matchId, result](Database &database)
+                 { return database.recordResult(tournamentId, matchId, result).getId() == matchId; },
+                 tournamentId);
+}
+
+QFuture<QList<Match>> AsyncDatabase::getAllMatches(int tournamentId)
+{
+    return read<QList<Match>>([tournamentId](Database &database)
+                              { return database.getAllMatches(tournamentId); });
+}
+
+QFuture<QList<Player>> AsyncDatabase::getPlayersForTournament(int tournamentId)
+{
+    return read<QList<Player>>([tournamentId](Database &database)
+                               { return database.getPlayersForTournament(tournamentId); });
+}
+
+void AsyncDatabase::enqueue(const Task &task)
+{
+    QMutexLocker locker(&mutex);
+    queue.append(task);
+    queueChanged.wakeOne();
+}
+
+void AsyncDatabase::run()
+{
+    // The connection must be created and used on this thread
+    Database database(databasePath, connectionName);
+    if (queryStats)
+    {
+        database.setQueryStats(queryStats);
+    }
+    bool ok = database.connect();
+
+    {
+        QMutexLocker locker(&mutex);
+        openFinished = true;
+        openSucceeded = ok;
+        openChanged.wakeAll();
+    }
+
+    forever
+    {
+        // Take everything queued so far in one go
+        QList<Task> batch;
+        {
+            QMutexLocker locker(&mutex);
+            while (queue.isEmpty() && !stopping)
+            {
+                queueChanged.wait(&mutex);
+            }
+            if (queue.isEmpty())
+            {
+                break;
+            }
+            batch.swap(queue);
+        }
+
+        // Run in order, grouping consecutive writes into one transaction
+        QList<Task> writes;
+        for (Task &task : batch)
+        {
+            if (task.isWrite)
+            {
+                if (!writes.isEmpty() && writes.last().tournamentId != task.tournamentId)
+                {
+                    runWrites(database, writes);
+                }
+                writes.append(task);
+                continue;
+            }
+
+            runWrites(database, writes);
+            task.run(database);
+        }
+        runWrites(database, writes);
+    }
+}
+
+void AsyncDatabase::runWrites(Database &database, QList<Task> &writes)
+{
+    if (writes.isEmpty())
+    {
+        return;
+    }
+
+    // Tournament files can only be switched outside a transaction
+    if (writes.first().tournamentId != -1)
+    {
+        database.attachTournament(writes.first().tournamentId);
+    }
+
+    QList<bool> results;
+    database.beginTransaction();
+    for (Task &task : writes)
+    {
+        results.append(task.run(database));
+    }
+
+    if (database.commitTransaction())
+    {
+        for (int i = 0; i < writes.size(); ++i)
+        {
+            writes[i].complete(results[i]);
+        }
+    }
+    else
+    {
+        // One write failed and took the group down with it; the group was
+        // rolled back, so run each write again on its own
+        qDebug() << "Grouped commit of" << writes.size() << "writes failed, retrying individually";
+        for (Task &task : writes)
+        {
+            task.complete(task.run(database));
+        }
+    }
+
+    writes.clear();
+}
@@ -0,0 +1,97 @@
+#ifndef ASYNCDATABASE_H
+#define ASYNCDATABASE_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFuture>
+#include <QPromise>
+#include <QList>
+#include <QString>
+#include <functional>
+#include <memory>
+#include "Database.h"
+
+// Runs Database calls on a dedicated thread that owns its own connection, so
+// SQLite writes and fsyncs never block the GUI. Requests are queued in order
+// and answered through QFutures. Writes queued while the worker is busy are
+// grouped into a single transaction, so a burst of submissions costs one commit.
+// The worker counts its statements into the given stats sink, if any.
+class AsyncDatabase : public QThread
+{
+public:
+    explicit AsyncDatabase(const QString &databasePath,
+                           const std::shared_ptr<QueryStats> &queryStats = std::shared_ptr<QueryStats>(),
+                           QObject *parent = nullptr);
+    ~AsyncDatabase() override;
+
+    // Start the worker and wait until its connection is open
+    bool open();
+
+    // Finish every queued request, then stop the worker
+    void stop();
+
+    // Queue a read; the future carries the job's return value
+    template <typename T>
+    QFuture<T> read(std::function<T(Database &)> job);
+
+    // Queue a write; the future carries the job's result once it is committed.
+    // Give the tournament it writes to, so the split layout can attach its
+    // file before the group's transaction begins.
+    QFuture<bool> write(std::function<bool(Database &)> job, int tournamentId = -1);
+
+    // Convenience requests
+    QFuture<bool> submitResult(int tournamentId, int matchId, const QString &result);
+    QFuture<QList<Match>> getAllMatches(int tournamentId);
+    QFuture<QList<Player>> getPlayersForTournament(int tournamentId);
+
+protected:
+    void run() override;
+
+private:
+    struct Task
+    {
+        bool isWrite;
+        int tournamentId; // Writes only; consecutive writes to one tournament share a transaction
+        std::function<bool(Database &)> run;
+        std::function<void(bool)> complete; // Called with the write's result after commit
+    };
+
+    void enqueue(const Task &task);
+    void runWrites(Database &database, QList<Task> &writes);
+
+    QString databasePath;
+    QString connectionName;
+    std::shared_ptr<QueryStats> queryStats;
+
+    QMutex mutex;
+    QWaitCondition queueChanged;
+    QWaitCondition openChanged;
+    QList<Task> queue;
+    bool stopping;
+    bool openFinished;
+    bool openSucceeded;
+};
+
+template <typename T>
+QFuture<T> AsyncDatabase::read(std::function<T(Database &)> job)
+{
+    auto promise = std::make_shared<QPromise<T>>();
+    promise->start();
+    QFuture<T> future = promise->future();
+
+    Task task;
+    task.isWrite = false;
+    task.tournamentId = -1;
+    task.run = [promise, job](Database &database)
+    {
+        promise->addResult(job(database));
+        promise->finish();
+        return true;
+    };
+    enqueue(task);
+
+    return future;
+}
+
+#endif // ASYNCDATABASE_H
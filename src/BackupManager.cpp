@@ -0,0 +1,300 @@
+#include "BackupManager.h"
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QDeadlineTimer>
+#include <QDateTime>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+#include "Database.h"
+#include "Trace.h"
+
+BackupManager::BackupManager(const QString &databasePath, const QString &backupDirectory, QObject *parent)
+    : QThread(parent), databasePath(databasePath.isEmpty() ? Database::defaultDatabasePath() : databasePath),
+      backupDirectory(backupDirectory.isEmpty() ? defaultBackupDirectory() : backupDirectory),
+      intervalMinutes(0), keepCount(10), scheduleChanged(false), stopping(false)
+{
+    // Each instance needs its own connection names
+    static QAtomicInt nextInstance;
+    connectionName = QString("backup_%1").arg(nextInstance.fetchAndAddRelaxed(1));
+}
+
+BackupManager::~BackupManager()
+{
+    stop();
+}
+
+QString BackupManager::defaultBackupDirectory()
+{
+    return QCoreApplication::applicationDirPath() + "/backups";
+}
+
+QString BackupManager::getBackupDirectory() const
+{
+    return backupDirectory;
+}
+
+void BackupManager::setSchedule(int intervalMinutes, int keepCount)
+{
+    QMutexLocker locker(&mutex);
+    this->intervalMinutes = intervalMinutes;
+    this->keepCount = qMax(1, keepCount);
+    scheduleChanged = true;
+    stateChanged.wakeAll();
+}
+
+QFuture<QString> BackupManager::backupNow()
+{
+    auto promise = std::make_shared<QPromise<QString>>();
+    promise->start();
+    QFuture<QString> future = promise->future();
+
+    QMutexLocker locker(&mutex);
+    requests.append(promise);
+    stateChanged.wakeAll();
+
+    return future;
+}
+
+void BackupManager::stop()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        stateChanged.wakeAll();
+    }
+
+    wait();
+
+    // Requests the worker never got to
+    for (const auto &promise : requests)
+    {
+        promise->addResult(QString());
+        promise->finish();
+    }
+    requests.clear();
+}
+
+void BackupManager::run()
+{
+    // The source connection only reads, so it can never block or fail a write
+    Database source(databasePath, connectionName, Database::ReadOnly);
+    if (!source.open())
+    {
+        qDebug() << "Backups disabled, cannot open" << databasePath;
+        return;
+    }
+
+    QDeadlineTimer nextBackup(QDeadlineTimer::Forever);
+
+    forever
+    {
+        QList<std::shared_ptr<QPromise<QString>>> waiting;
+        int keep;
+        {
+            QMutexLocker locker(&mutex);
+            while (!stopping && requests.isEmpty())
+            {
+                if (scheduleChanged)
+                {
+                    nextBackup = intervalMinutes > 0 ? QDeadlineTimer(qint64(intervalMinutes) * 60 * 1000)
+                                                     : QDeadlineTimer(QDeadlineTimer::Forever);
+                    scheduleChanged = false;
+                }
+                if (nextBackup.hasExpired())
+                {
+                    break;
+                }
+                stateChanged.wait(&mutex, nextBackup);
+            }
+            if (stopping)
+            {
+                break;
+            }
+            waiting.swap(requests);
+            keep = keepCount;
+        }
+
+        // One backup answers every request queued while the last one ran
+        QString path = runBackup(source);
+        if (!path.isEmpty())
+        {
+            rotate(keep);
+        }
+
+        for (const auto &promise : waiting)
+        {
+            promise->addResult(path);
+            promise->finish();
+        }
+
+        {
+            QMutexLocker locker(&mutex);
+            nextBackup = intervalMinutes > 0 ? QDeadlineTimer(qint64(intervalMinutes) * 60 * 1000)
+                                             : QDeadlineTimer(QDeadlineTimer::Forever);
+        }
+    }
+}
+
+QString BackupManager::runBackup(Database &source)
+{
+    OT_TRACE_SCOPE("BackupManager::runBackup");
+    QDir directory(backupDirectory);
+    if (!directory.mkpath("."))
+    {
+        qDebug() << "Cannot create backup directory" << backupDirectory;
+        return QString();
+    }
+
+    // A backup never replaces an earlier one, even within the same millisecond
+    QString stamp = "tournament-" + QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss-zzz");
+    QString path = directory.filePath(stamp + ".db");
+    for (int suffix = 1; QFile::exists(path); ++suffix)
+    {
+        path = directory.filePath(QString("%1-%2.db").arg(stamp).arg(suffix));
+    }
+    QString partPath = path + ".part";
+    QFile::remove(partPath);
+
+    // A split catalog's tournament files are copied to where the copied
+    // catalog looks for them, so the backup opens like the original
+    const bool split = source.isSplitLayout();
+    QString tournamentDirectory = Database::tournamentDirectoryFor(path);
+    QString partDirectory = tournamentDirectory + ".part";
+    QDir(partDirectory).removeRecursively();
+
+    bool ok = copyDatabase(source, partPath);
+
+    if (ok && split)
+    {
+        ok = QDir().mkpath(partDirectory);
+        for (int tournamentId : source.getTournamentFileIds())
+        {
+            QString tournamentPath = source.getTournamentFilePath(tournamentId);
+            Database tournament(tournamentPath, connectionName + "_tournament", Database::ReadOnly);
+            ok = ok && tournament.open() &&
+                 copyDatabase(tournament, QDir(partDirectory).filePath(QFileInfo(tournamentPath).fileName()));
+            if (!ok)
+            {
+                qDebug() << "Backup of tournament file" << tournamentPath << "failed";
+                break;
+            }
+        }
+    }
+
+    if (ok)
+    {
+        QFile::remove(path);
+        QDir(tournamentDirectory).removeRecursively();
+        ok = QFile::rename(partPath, path) && (!split || QDir().rename(partDirectory, tournamentDirectory));
+    }
+
+    if (!ok)
+    {
+        qDebug() << "Backup of" << databasePath << "failed";
+        QFile::remove(partPath);
+        QDir(partDirectory).removeRecursively();
+        return QString();
+    }
+
+    return path;
+}
+
+bool BackupManager::copyDatabase(Database &source, const QString &partPath)
+{
+    bool ok;
+    {
+        // The target keeps SQLite's default journal mode: a WAL destination
+        // with another page size than the source cannot be written to
+        Database target(partPath, connectionName + "_target", Database::Unconfigured);
+        if (!target.open())
+        {
+            return false;
+        }
+
+        // A file in WAL mode is read from a snapshot that never blocks writers,
+        // so it is copied in one step; a step-wise copy would restart after
+        // every write committed in between
+        ok = source.isInMemory() ? source.copyTo(target, MemoryPagesPerStep, MemoryStepPauseMs)
+                                 : source.copyTo(target);
+    }
+
+    if (ok)
+    {
+        Database check(partPath, connectionName + "_check", Database::Unconfigured);
+        ok = check.open() && check.quickCheck();
+    }
+
+    return ok;
+}
+
+bool BackupManager::restore(const QString &backupPath, Database &database)
+{
+    OT_TRACE_SCOPE("BackupManager::restore");
+    static QAtomicInt nextRestore;
+    const QString name = QString("restore_%1").arg(nextRestore.fetchAndAddRelaxed(1));
+
+    Database backup(backupPath, name, Database::ReadOnly);
+    if (!backup.open() || !backup.quickCheck())
+    {
+        qDebug() << "Cannot restore" << backupPath << ": not a readable, intact database";
+        return false;
+    }
+
+    // A single-file backup cannot be laid over split tournament files, nor
+    // the other way round
+    if (backup.isSplitLayout() != database.isSplitLayout())
+    {
+        qDebug() << "Cannot restore" << backupPath << ": its layout differs from" << database.getDatabasePath();
+        return false;
+    }
+
+    if (!backup.copyTo(database))
+    {
+        qDebug() << "Restoring" << backupPath << "failed";
+        return false;
+    }
+
+    if (!backup.isSplitLayout())
+    {
+        return true;
+    }
+
+    // Live files the backup does not list are removed as orphans the next
+    // time the schema is initialized
+    QDir directory(database.getTournamentDirectory());
+    if (!directory.mkpath("."))
+    {
+        qDebug() << "Cannot create tournament directory" << directory.path();
+        return false;
+    }
+
+    for (int tournamentId : backup.getTournamentFileIds())
+    {
+        QString sourcePath = backup.getTournamentFilePath(tournamentId);
+        Database source(sourcePath, name + "_source", Database::ReadOnly);
+        Database target(directory.filePath(QFileInfo(sourcePath).fileName()), name + "_target",
+                        Database::Unconfigured);
+        if (!source.open() || !target.open() || !source.copyTo(target))
+        {
+            qDebug() << "Restoring tournament file" << sourcePath << "failed";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void BackupManager::rotate(int keep)
+{
+    // Timestamped names sort oldest first
+    QDir directory(backupDirectory);
+    QStringList backups = directory.entryList(QStringList() << "tournament-*.db", QDir::Files, QDir::Name);
+    for (int i = 0; i < backups.size() - keep; ++i)
+    {
+        directory.remove(backups[i]);
+        QDir(Database::tournamentDirectoryFor(directory.filePath(backups[i]))).removeRecursively();
+    }
+}
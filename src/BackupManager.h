@@ -0,0 +1,70 @@
+#ifndef BACKUPMANAGER_H
+#define BACKUPMANAGER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFuture>
+#include <QPromise>
+#include <QList>
+#include <QString>
+#include <memory>
+
+class Database;
+
+// Takes hot backups of the live database on a dedicated thread through the
+// SQLite online backup API, on a schedule or on request. Each backup is
+// written to a .part file, checked with PRAGMA quick_check and only then
+// renamed into place; the oldest backups beyond the keep count are deleted.
+// A split catalog is backed up together with every tournament file.
+class BackupManager : public QThread
+{
+public:
+    BackupManager(const QString &databasePath, const QString &backupDirectory, QObject *parent = nullptr);
+    ~BackupManager() override;
+
+    // Back up every intervalMinutes (0 disables the schedule), keeping the newest keepCount files
+    void setSchedule(int intervalMinutes, int keepCount);
+
+    // Queue a backup; the future carries the new file's path, or an empty string on failure
+    QFuture<QString> backupNow();
+
+    // Finish a backup in progress, then stop the worker
+    void stop();
+
+    QString getBackupDirectory() const;
+    static QString defaultBackupDirectory();
+
+    // Copy a backup, with its tournament files, over the database the
+    // connection uses. The copy goes through the backup API, so connections
+    // on other threads see the restored data and no stale WAL is replayed
+    // over it. The backup must have the connection's layout.
+    static bool restore(const QString &backupPath, Database &database);
+
+protected:
+    void run() override;
+
+private:
+    QString runBackup(Database &source);
+    bool copyDatabase(Database &source, const QString &partPath); // Copy and check one file
+    void rotate(int keep);
+
+    // In-memory databases lock the shared cache while a step runs, so they
+    // are copied in small batches with pauses in between
+    static const int MemoryPagesPerStep = 64;
+    static const int MemoryStepPauseMs = 2;
+
+    QString databasePath;
+    QString backupDirectory;
+    QString connectionName;
+
+    QMutex mutex;
+    QWaitCondition stateChanged;
+    QList<std::shared_ptr<QPromise<QString>>> requests;
+    int intervalMinutes;
+    int keepCount;
+    bool scheduleChanged;
+    bool stopping;
+};
+
+#endif // BACKUPMANAGER_H
@@ -0,0 +1,235 @@
+#include "BatchEntry.h"
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QStandardPaths>
+#include <QDir>
+#include <QDebug>
+
+// Journal format: a "tournament <id>" header line, followed by one
+// "<matchId> <result>" line per staged result. A result of "-" unstages
+// the match. Later lines override earlier ones.
+
+BatchEntry::BatchEntry(const QString &journalPath)
+    : journalPath(journalPath.isEmpty() ? getDefaultJournalPath() : journalPath), tournamentId(-1)
+{
+}
+
+void BatchEntry::begin(int tournamentId)
+{
+    if (this->tournamentId == tournamentId)
+    {
+        return;
+    }
+
+    this->tournamentId = tournamentId;
+    staged.clear();
+    rewriteJournal();
+}
+
+bool BatchEntry::stage(int matchId, const QString &result)
+{
+    if (tournamentId < 0 || result.isEmpty())
+    {
+        return false;
+    }
+
+    // Write through to the journal before accepting the result
+    if (!appendToJournal(QString("%1 %2").arg(matchId).arg(result)))
+    {
+        return false;
+    }
+
+    staged.insert(matchId, result);
+    return true;
+}
+
+bool BatchEntry::unstage(int matchId)
+{
+    if (!staged.contains(matchId))
+    {
+        return false;
+    }
+
+    if (!appendToJournal(QString("%1 -").arg(matchId)))
+    {
+        return false;
+    }
+
+    staged.remove(matchId);
+    return true;
+}
+
+void BatchEntry::clear()
+{
+    staged.clear();
+    tournamentId = -1;
+    QFile::remove(journalPath);
+}
+
+// Getters
+int BatchEntry::getTournamentId() const
+{
+    return tournamentId;
+}
+
+QMap<int, QString> BatchEntry::getStagedResults() const
+{
+    return staged;
+}
+
+QString BatchEntry::getStagedResult(int matchId) const
+{
+    return staged.value(matchId);
+}
+
+bool BatchEntry::isStaged(int matchId) const
+{
+    return staged.contains(matchId);
+}
+
+bool BatchEntry::isEmpty() const
+{
+    return staged.isEmpty();
+}
+
+int BatchEntry::count() const
+{
+    return staged.size();
+}
+
+QString BatchEntry::getJournalPath() const
+{
+    return journalPath;
+}
+
+bool BatchEntry::loadJournal()
+{
+    QFile file(journalPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QTextStream in(&file);
+    int journalTournamentId = -1;
+    QMap<int, QString> journalResults;
+
+    while (!in.atEnd())
+    {
+        QStringList fields = in.readLine().split(' ', Qt::SkipEmptyParts);
+        if (fields.size() != 2)
+        {
+            continue; // Skip blank or partially written lines
+        }
+
+        if (fields[0] == "tournament")
+        {
+            journalTournamentId = fields[1].toInt();
+            journalResults.clear();
+            continue;
+        }
+
+        bool ok;
+        int matchId = fields[0].toInt(&ok);
+        if (!ok)
+        {
+            continue;
+        }
+
+        if (fields[1] == "-")
+        {
+            journalResults.remove(matchId);
+        }
+        else if (fields[1] == "p1" || fields[1] == "p2" || fields[1] == "draw")
+        {
+            journalResults.insert(matchId, fields[1]);
+        }
+    }
+
+    file.close();
+
+    if (journalTournamentId < 0)
+    {
+        return false;
+    }
+
+    tournamentId = journalTournamentId;
+    staged = journalResults;
+
+    // Compact the journal now that its state is known
+    rewriteJournal();
+
+    return !staged.isEmpty();
+}
+
+QString BatchEntry::resultForKey(QChar key)
+{
+    if (key == '1')
+    {
+        return "p1";
+    }
+    else if (key == '0')
+    {
+        return "p2";
+    }
+    else if (key == '=')
+    {
+        return "draw";
+    }
+
+    return QString();
+}
+
+bool BatchEntry::appendToJournal(const QString &line)
+{
+    QFile file(journalPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+    {
+        qDebug() << "Failed to open batch journal:" << file.errorString();
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << line << "\n";
+    out.flush();
+
+    file.close();
+    return file.error() == QFile::NoError;
+}
+
+bool BatchEntry::rewriteJournal()
+{
+    QFile file(journalPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qDebug() << "Failed to rewrite batch journal:" << file.errorString();
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "tournament " << tournamentId << "\n";
+    for (auto it = staged.constBegin(); it != staged.constEnd(); ++it)
+    {
+        out << it.key() << " " << it.value() << "\n";
+    }
+    out.flush();
+
+    file.close();
+    return true;
+}
+
+QString BatchEntry::getDefaultJournalPath() const
+{
+    // Keep the journal next to the settings file
+    QString appDataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+
+    // Create directory if it doesn't exist
+    QDir dir;
+    if (!dir.exists(appDataDir))
+    {
+        dir.mkpath(appDataDir);
+    }
+
+    return appDataDir + "/batch_results.journal";
+}
@@ -0,0 +1,53 @@
+#ifndef BATCHENTRY_H
+#define BATCHENTRY_H
+
+#include <QString>
+#include <QMap>
+#include <QChar>
+
+// Holds match results staged during batch entry until they are committed
+// in a single transaction. Every change is appended to a journal file so
+// the staged set survives an application crash.
+class BatchEntry
+{
+public:
+    // Constructor
+    explicit BatchEntry(const QString &journalPath = QString());
+
+    // Start staging results for a tournament, dropping results staged for another one
+    void begin(int tournamentId);
+
+    // Stage or unstage the result of a match
+    bool stage(int matchId, const QString &result);
+    bool unstage(int matchId);
+
+    // Drop all staged results and truncate the journal
+    void clear();
+
+    // Getters
+    int getTournamentId() const;
+    QMap<int, QString> getStagedResults() const;
+    QString getStagedResult(int matchId) const;
+    bool isStaged(int matchId) const;
+    bool isEmpty() const;
+    int count() const;
+    QString getJournalPath() const;
+
+    // Restore results staged by a previous session from the journal
+    bool loadJournal();
+
+    // Map a result key to a match result: '1' → "p1", '0' → "p2", '=' → "draw"
+    static QString resultForKey(QChar key);
+
+private:
+    QString journalPath;
+    int tournamentId;
+    QMap<int, QString> staged; // Match ID → result
+
+    // Helper methods
+    bool appendToJournal(const QString &line);
+    bool rewriteJournal();
+    QString getDefaultJournalPath() const;
+};
+
+#endif // BATCHENTRY_H
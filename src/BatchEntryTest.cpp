@@ -0,0 +1,114 @@
+#include <QtTest/QtTest>
+#include <QFile>
+
+#include "BatchEntryTest.h"
+#include "BatchEntry.h"
+
+void BatchEntryTest::initTestCase()
+{
+    QVERIFY(tempDir.isValid());
+}
+
+QString BatchEntryTest::journalPath(const QString &name) const
+{
+    return tempDir.filePath(name + ".journal");
+}
+
+void BatchEntryTest::testReloadReplaysUnstage()
+{
+    const QString path = journalPath("unstage");
+    {
+        BatchEntry batch(path);
+        batch.begin(7);
+        QVERIFY(batch.stage(1, "p1"));
+        QVERIFY(batch.stage(2, "draw"));
+        QVERIFY(batch.stage(3, "p2"));
+        QVERIFY(batch.unstage(2));
+        QVERIFY(batch.stage(1, "p2")); // Later lines override earlier ones
+        QVERIFY(!batch.unstage(4));
+    }
+
+    // A new session sees what the crashed one had staged
+    BatchEntry restored(path);
+    QVERIFY(restored.loadJournal());
+    QCOMPARE(restored.getTournamentId(), 7);
+    QMap<int, QString> expected{{1, "p2"}, {3, "p2"}};
+    QCOMPARE(restored.getStagedResults(), expected);
+
+    // Loading compacts the journal to the current state
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QCOMPARE(QString::fromUtf8(file.readAll()), QString("tournament 7\n1 p2\n3 p2\n"));
+}
+
+void BatchEntryTest::testReloadKeepsLastTournament()
+{
+    const QString path = journalPath("tournament");
+    {
+        BatchEntry batch(path);
+        batch.begin(7);
+        QVERIFY(batch.stage(1, "p1"));
+
+        // Switching tournaments drops the results staged for the first one
+        batch.begin(8);
+        QVERIFY(batch.stage(5, "draw"));
+    }
+
+    BatchEntry restored(path);
+    QVERIFY(restored.loadJournal());
+    QCOMPARE(restored.getTournamentId(), 8);
+    QMap<int, QString> expected{{5, "draw"}};
+    QCOMPARE(restored.getStagedResults(), expected);
+
+    // A header later in the file starts over as well
+    const QString appendedPath = journalPath("appended");
+    QFile file(appendedPath);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    file.write("tournament 3\n1 p1\ntournament 4\n2 draw\n");
+    file.close();
+
+    BatchEntry appended(appendedPath);
+    QVERIFY(appended.loadJournal());
+    QCOMPARE(appended.getTournamentId(), 4);
+    QMap<int, QString> appendedExpected{{2, "draw"}};
+    QCOMPARE(appended.getStagedResults(), appendedExpected);
+}
+
+void BatchEntryTest::testReloadSkipsTornLines()
+{
+    // A crash can leave the last line half written
+    const QString path = journalPath("torn");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    file.write("tournament 3\n1 p1\n\n2 -\n3 dr");
+    file.close();
+
+    BatchEntry restored(path);
+    QVERIFY(restored.loadJournal());
+    QCOMPARE(restored.getTournamentId(), 3);
+    QMap<int, QString> expected{{1, "p1"}};
+    QCOMPARE(restored.getStagedResults(), expected);
+}
+
+void BatchEntryTest::testReloadWithNothingStaged()
+{
+    const QString path = journalPath("empty");
+    {
+        BatchEntry batch(path);
+        batch.begin(9);
+        QVERIFY(batch.stage(1, "p1"));
+        QVERIFY(batch.unstage(1));
+    }
+
+    BatchEntry restored(path);
+    QVERIFY(!restored.loadJournal());
+    QVERIFY(restored.isEmpty());
+
+    // No journal at all, e.g. after the batch was committed and cleared
+    BatchEntry cleared(journalPath("missing"));
+    QVERIFY(!cleared.loadJournal());
+    QCOMPARE(cleared.getTournamentId(), -1);
+}
+
+QTEST_MAIN(BatchEntryTest)
+#include "BatchEntryTest.moc"
@@ -0,0 +1,24 @@
+#ifndef BATCHENTRYTEST_H
+#define BATCHENTRYTEST_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class BatchEntryTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testReloadReplaysUnstage();
+    void testReloadKeepsLastTournament();
+    void testReloadSkipsTornLines();
+    void testReloadWithNothingStaged();
+
+private:
+    QString journalPath(const QString &name) const;
+
+    QTemporaryDir tempDir;
+};
+
+#endif // BATCHENTRYTEST_H
@@ -1,49 +1,317 @@
 #include "Database.h"
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlDriver>
+#include <QThread>
 #include <QStandardPaths>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QDeadlineTimer>
+#include <QStringList>
+#include <QSet>
+#include "Trace.h"
 
-Database::Database()
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+#include <sqlite3.h>
+#endif
+
+namespace
+{
+    // How long a connection waits for another one's locks before failing
+    const int BusyTimeoutMs = 5000;
+    const int LockPollMs = 2;
+
+    // In-memory databases share one cache whose table locks fail at once
+    // with SQLITE_LOCKED (or its SHAREDCACHE extension) and ignore busy_timeout
+    bool isTableLockError(const QSqlError &error)
+    {
+        const QString code = error.nativeErrorCode();
+        return code == "6" || code == "262";
+    }
+
+    // Remove a database file with its WAL and shared-memory files; false if
+    // any of them is still there, e.g. held open by another connection on Windows
+    bool removeDatabaseFile(const QString &path)
+    {
+        bool removed = true;
+        for (const QString &file : {path + "-wal", path + "-shm", path})
+        {
+            removed = (!QFile::exists(file) || QFile::remove(file)) && removed;
+        }
+        return removed;
+    }
+
+    // Tournament timestamps are stored as integer seconds since the epoch
+    QDateTime dateTimeFromEpoch(const QVariant &value)
+    {
+        return value.isNull() ? QDateTime() : QDateTime::fromSecsSinceEpoch(value.toLongLong());
+    }
+
+    QVariant epochFromDateTime(const QDateTime &dateTime)
+    {
+        return dateTime.isValid() ? QVariant(dateTime.toSecsSinceEpoch()) : QVariant();
+    }
+
+    // Recompute the player_standings rows of the player_tournaments rows that
+    // match the condition. Points are kept in half points so they stay integers.
+    QString refreshStandingsSql(const QString &condition)
+    {
+        return QString(R"(
+            INSERT OR REPLACE INTO player_standings (tournament_id, player_id, half_points, wins, losses, draws, games)
+            SELECT pt.tournament_id, pt.player_id,
+                   COALESCE(SUM(CASE WHEN m.result = 'draw' THEN 1
+                                     WHEN m.result = CASE WHEN m.p1 = pt.player_id THEN 'p1' ELSE 'p2' END THEN 2
+                                     ELSE 0 END), 0),
+                   COALESCE(SUM(m.result = CASE WHEN m.p1 = pt.player_id THEN 'p1' ELSE 'p2' END), 0),
+                   COALESCE(SUM(m.result = CASE WHEN m.p1 = pt.player_id THEN 'p2' ELSE 'p1' END), 0),
+                   COALESCE(SUM(m.result = 'draw'), 0),
+                   COUNT(m.result)
+            FROM player_tournaments pt
+            LEFT JOIN matches m ON m.tournament_id = pt.tournament_id AND pt.player_id IN (m.p1, m.p2)
+                               AND m.result IN ('p1', 'p2', 'draw')
+            WHERE %1
+            GROUP BY pt.tournament_id, pt.player_id;
+        )")
+            .arg(condition);
+    }
+
+    // Trigger statement adding (sign "+") or removing ("-") one side of a
+    // match row's result. Unknown results and unregistered players are
+    // skipped, as they are by Standings::compute().
+    QString standingsDeltaSql(const QString &row, const QString &side, const QString &otherSide, const QString &sign)
+    {
+        return QString(R"(
+            UPDATE player_standings
+            SET half_points = half_points %4 CASE %1.result WHEN '%2' THEN 2 WHEN 'draw' THEN 1 ELSE 0 END,
+                wins = wins %4 (%1.result = '%2'),
+                losses = losses %4 (%1.result = '%3'),
+                draws = draws %4 (%1.result = 'draw'),
+                games = games %4 1
+            WHERE tournament_id = %1.tournament_id AND player_id = %1.%2
+              AND %1.result IN ('p1', 'p2', 'draw');
+        )")
+            .arg(row, side, otherSide, sign);
+    }
+
+    QString standingsDeltaSql(const QString &row, const QString &sign)
+    {
+        return standingsDeltaSql(row, "p1", "p2", sign) + standingsDeltaSql(row, "p2", "p1", sign);
+    }
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    // The driver's sqlite3 handle, or nullptr if it is not a SQLite connection
+    sqlite3 *driverHandle(const QSqlDatabase &db)
+    {
+        QVariant handle = db.isOpen() ? db.driver()->handle() : QVariant();
+        if (!handle.isValid() || qstrcmp(handle.typeName(), "sqlite3*") != 0)
+        {
+            return nullptr;
+        }
+        return *static_cast<sqlite3 *const *>(handle.constData());
+    }
+
+    // Cached native statement borrowed for one call and reset when it goes out of scope
+    class NativeStatement
+    {
+    public:
+        explicit NativeStatement(sqlite3_stmt *statement)
+            : statement(statement)
+        {
+        }
+
+        ~NativeStatement()
+        {
+            if (statement)
+            {
+                sqlite3_reset(statement);
+                sqlite3_clear_bindings(statement);
+            }
+        }
+
+        bool isValid() const { return statement != nullptr; }
+        void bind(int index, int value) { sqlite3_bind_int(statement, index, value); }
+
+        // True while there is a row; check isDone() afterwards for errors.
+        // A shared-cache table lock is waited out like busy_timeout would,
+        // as long as no row has been read yet.
+        bool step()
+        {
+            status = sqlite3_step(statement);
+            if ((status & 0xff) == SQLITE_LOCKED && !stepped)
+            {
+                QElapsedTimer timer;
+                timer.start();
+                while ((status & 0xff) == SQLITE_LOCKED && timer.elapsed() < BusyTimeoutMs)
+                {
+                    QThread::msleep(LockPollMs);
+                    sqlite3_reset(statement);
+                    status = sqlite3_step(statement);
+                }
+            }
+            stepped = true;
+            return status == SQLITE_ROW;
+        }
+        bool isDone() const { return status == SQLITE_DONE; }
+
+        int intValue(int column) const { return sqlite3_column_int(statement, column); }
+        double doubleValue(int column) const { return sqlite3_column_double(statement, column); }
+        QString textValue(int column) const
+        {
+            const char *text = reinterpret_cast<const char *>(sqlite3_column_text(statement, column));
+            return text ? QString::fromUtf8(text, sqlite3_column_bytes(statement, column)) : QString();
+        }
+
+    private:
+        sqlite3_stmt *statement = nullptr;
+        int status = SQLITE_OK;
+        bool stepped = false;
+    };
+#endif
+}
+
+Database::Database(const QString &databasePath, const QString &connectionName, AccessMode accessMode)
+    : connectionName(connectionName), accessMode(accessMode), transactionDepth(0), transactionFailed(false),
+      nativeDecoding(true), splitLayout(false), playerSearchIndex(false), attachedTournamentId(-1),
+      queryStats(std::make_shared<QueryStats>())
 {
-    // Set database path to application directory
-    QString appDir = QCoreApplication::applicationDirPath();
-    dbPath = appDir + "/tournament.db";
-    db = QSqlDatabase::addDatabase("QSQLITE");
+    // Set database path to application directory unless given
+    dbPath = databasePath.isEmpty() ? defaultDatabasePath() : databasePath;
+
+    if (connectionName.isEmpty())
+    {
+        db = QSqlDatabase::addDatabase("QSQLITE");
+    }
+    else
+    {
+        db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    }
     db.setDatabaseName(dbPath);
+
+    // URI filenames are needed for in-memory databases and to attach them
+    db.setConnectOptions(accessMode == ReadOnly ? "QSQLITE_OPEN_URI;QSQLITE_OPEN_READONLY" : "QSQLITE_OPEN_URI");
 }
 
 Database::~Database()
 {
+    // Cached statements must be released before their connection closes
+    clearStatementCache();
+
     if (db.isOpen())
     {
         db.close();
     }
+
+    // Named connections belong to this object, so release them as well
+    if (!connectionName.isEmpty())
+    {
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+}
+
+QString Database::defaultDatabasePath()
+{
+    return QCoreApplication::applicationDirPath() + "/tournament.db";
+}
+
+QString Database::getDatabasePath() const
+{
+    return dbPath;
+}
+
+QString Database::inMemoryPath(const QString &name)
+{
+    return QString("file:%1?mode=memory&cache=shared").arg(name);
+}
+
+bool Database::isInMemory() const
+{
+    return dbPath.startsWith("file:") && dbPath.contains("mode=memory");
 }
 
 bool Database::connect()
 {
-    if (!db.isOpen())
+    OT_TRACE_SCOPE("Database::connect");
+    if (!open())
     {
-        if (!db.open())
-        {
-            qDebug() << "Failed to open database:" << db.lastError().text();
-            return false;
-        }
+        return false;
     }
 
     // Initialize schema if needed
     return initializeSchema();
 }
 
+bool Database::open()
+{
+    OT_TRACE_SCOPE("Database::open");
+    if (db.isOpen())
+    {
+        return true;
+    }
+
+    if (!db.open())
+    {
+        qDebug() << "Failed to open database:" << db.lastError().text();
+        return false;
+    }
+
+    // Write-ahead logging lets other connections (startup loader, async
+    // worker, read pool) read while this one writes; wait rather than fail on
+    // locks. Read-only connections cannot change the journal mode.
+    // Incremental vacuum only takes effect on a new, still empty file, so it
+    // is asked for first; runMaintenance() gives the freed pages back later.
+    // In-memory databases have table locks instead, which exec() waits out.
+    QSqlQuery query(db);
+    bool configured = exec(query, QString("PRAGMA busy_timeout = %1").arg(BusyTimeoutMs));
+    if (accessMode == ReadWrite)
+    {
+        configured = configured && exec(query, "PRAGMA auto_vacuum = INCREMENTAL") &&
+                     exec(query, "PRAGMA journal_mode = WAL");
+    }
+
+    if (!configured)
+    {
+        qDebug() << "Failed to configure database connection:" << query.lastError().text();
+    }
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    // The driver's handle may only be passed to the linked SQLite if it is the
+    // one Qt uses; a Qt with its own bundled copy falls back to QtSql
+    sameSqlite = exec(query, "SELECT sqlite_source_id()") && next(query) &&
+                 query.value(0).toString() == QString::fromUtf8(sqlite3_sourceid());
+    if (!sameSqlite)
+    {
+        qDebug() << "Qt's SQLite" << query.value(0).toString() << "is not the linked" << sqlite3_sourceid()
+                 << "; using QtSql only";
+    }
+    query.finish();
+#endif
+
+    // A catalog that lists tournament files keeps each tournament in its own file
+    splitLayout = exec(query, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'tournament_files'") &&
+                  next(query);
+    query.finish();
+
+    // Created by initializeSchema() when this SQLite has FTS5
+    playerSearchIndex = exec(query, "SELECT 1 FROM sqlite_master WHERE name = 'players_fts'") && next(query);
+    query.finish();
+
+    return true;
+}
+
 void Database::disconnect()
 {
+    OT_TRACE_SCOPE("Database::disconnect");
+    clearStatementCache();
     if (db.isOpen())
     {
         db.close();
     }
+    attachedTournamentId = -1;
 }
 
 bool Database::isConnected() const
@@ -51,8 +319,256 @@ bool Database::isConnected() const
     return db.isOpen();
 }
 
+bool Database::exec(QSqlQuery &query)
+{
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = query.exec();
+    while (!ok && waitForTableLock(query, timer))
+    {
+        ok = query.exec();
+    }
+    recordStatement(query, timer.nsecsElapsed());
+    return ok;
+}
+
+bool Database::exec(QSqlQuery &query, const QString &sql)
+{
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = query.exec(sql);
+    while (!ok && waitForTableLock(query, timer))
+    {
+        ok = query.exec(sql);
+    }
+    recordStatement(query, timer.nsecsElapsed());
+    return ok;
+}
+
+bool Database::waitForTableLock(const QSqlQuery &query, const QElapsedTimer &timer) const
+{
+    // The statement failed as a whole, so running it again is safe
+    if (!isInMemory() || !isTableLockError(query.lastError()) || timer.elapsed() >= BusyTimeoutMs)
+    {
+        return false;
+    }
+
+    QThread::msleep(LockPollMs);
+    return true;
+}
+
+bool Database::next(QSqlQuery &query)
+{
+    // Count fetched rows against the statement the query last executed,
+    // found by its SQL text. Rows come in runs from one statement, so the
+    // last lookup is kept until the statement changes or the stats are reset.
+    bool more = query.next();
+    if (more)
+    {
+        const QString sql = query.lastQuery();
+        if (sql != countedSql || !queryStats->addRowsReturned(countedHandle, 1))
+        {
+            countedSql = sql;
+            countedHandle = queryStats->handleFor(sql);
+            queryStats->addRowsReturned(countedHandle, 1);
+        }
+    }
+    return more;
+}
+
+void Database::recordStatement(const QSqlQuery &query, qint64 durationNs)
+{
+    int rowsAffected = query.isSelect() ? 0 : query.numRowsAffected();
+    queryStats->record(query.lastQuery(), durationNs, rowsAffected);
+}
+
+QSqlQuery &Database::cachedQuery(const QString &sql)
+{
+    CachedStatement *&statement = statementCache[sql];
+    if (!statement)
+    {
+        statement = new CachedStatement{QSqlQuery(db), false};
+        statement->query.setForwardOnly(true);
+    }
+
+    // A failed prepare (e.g. before the schema exists) is retried on next use
+    if (!statement->prepared)
+    {
+        statement->prepared = statement->query.prepare(sql);
+        if (!statement->prepared)
+        {
+            qDebug() << "Failed to prepare statement:" << statement->query.lastError().text();
+        }
+    }
+
+    return statement->query;
+}
+
+void Database::clearStatementCache()
+{
+    for (CachedStatement *statement : std::as_const(statementCache))
+    {
+        delete statement;
+    }
+    statementCache.clear();
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    for (sqlite3_stmt *statement : std::as_const(nativeStatements))
+    {
+        sqlite3_finalize(statement);
+    }
+    nativeStatements.clear();
+#endif
+}
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+sqlite3 *Database::sqliteHandle() const
+{
+    return sameSqlite ? driverHandle(db) : nullptr;
+}
+
+sqlite3 *Database::nativeHandle() const
+{
+    return nativeDecoding ? sqliteHandle() : nullptr;
+}
+
+sqlite3_stmt *Database::nativeStatement(sqlite3 *handle, const QString &sql)
+{
+    auto it = nativeStatements.constFind(sql);
+    if (it != nativeStatements.constEnd())
+    {
+        return it.value();
+    }
+
+    sqlite3_stmt *statement = nullptr;
+    QByteArray utf8 = sql.toUtf8();
+    if (sqlite3_prepare_v3(handle, utf8.constData(), utf8.size(), SQLITE_PREPARE_PERSISTENT, &statement, nullptr) != SQLITE_OK)
+    {
+        qDebug() << "Failed to prepare native statement:" << sqlite3_errmsg(handle);
+        sqlite3_finalize(statement);
+        return nullptr;
+    }
+
+    nativeStatements.insert(sql, statement);
+    return statement;
+}
+
+void Database::recordNativeStatement(const QString &sql, qint64 durationNs, qint64 rowsReturned)
+{
+    queryStats->addRowsReturned(queryStats->record(sql, durationNs, 0), rowsReturned);
+}
+#endif
+
+void Database::setNativeDecoding(bool enabled)
+{
+    nativeDecoding = enabled;
+}
+
+bool Database::isNativeDecodingAvailable() const
+{
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    return nativeHandle() != nullptr;
+#else
+    return false;
+#endif
+}
+
+const QueryStats &Database::getQueryStats() const
+{
+    return *queryStats;
+}
+
+std::shared_ptr<QueryStats> Database::getSharedQueryStats() const
+{
+    return queryStats;
+}
+
+void Database::setQueryStats(const std::shared_ptr<QueryStats> &stats)
+{
+    queryStats = stats;
+    countedSql.clear();
+    countedHandle = QueryStats::Handle();
+}
+
+void Database::resetQueryStats()
+{
+    // Resets the sink for every connection sharing it
+    queryStats->reset();
+}
+
+bool Database::beginTransaction()
+{
+    OT_TRACE_SCOPE("Database::beginTransaction");
+    // Nested calls join the outermost transaction
+    if (transactionDepth++ > 0)
+    {
+        return true;
+    }
+
+    transactionFailed = false;
+    if (!db.transaction())
+    {
+        qDebug() << "Failed to begin transaction:" << db.lastError().text();
+        transactionDepth = 0;
+        return false;
+    }
+
+    return true;
+}
+
+bool Database::commitTransaction()
+{
+    OT_TRACE_SCOPE("Database::commitTransaction");
+    if (transactionDepth == 0)
+    {
+        return false;
+    }
+
+    // Only the outermost commit reaches SQLite
+    if (--transactionDepth > 0)
+    {
+        return !transactionFailed;
+    }
+
+    // A nested rollback dooms the whole transaction
+    if (transactionFailed)
+    {
+        db.rollback();
+        return false;
+    }
+
+    // The depth is already back to zero, so a caller cannot roll back after
+    // a failed commit; do it here rather than leave the transaction open
+    if (!db.commit())
+    {
+        qDebug() << "Failed to commit transaction:" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
+bool Database::rollbackTransaction()
+{
+    OT_TRACE_SCOPE("Database::rollbackTransaction");
+    if (transactionDepth == 0)
+    {
+        return false;
+    }
+
+    transactionFailed = true;
+    if (--transactionDepth > 0)
+    {
+        return true;
+    }
+
+    return db.rollback();
+}
+
 bool Database::initializeSchema()
 {
+    OT_TRACE_SCOPE("Database::initializeSchema");
     QSqlQuery query(db);
 
     // Create players table
@@ -64,7 +580,7 @@ bool Database::initializeSchema()
         )
     )";
 
-    if (!query.exec(createPlayersTable))
+    if (!exec(query, createPlayersTable))
     {
         qDebug() << "Failed to create players table:" << query.lastError().text();
         return false;
@@ -77,21 +593,406 @@ bool Database::initializeSchema()
             name TEXT,
             pairing_system TEXT DEFAULT NULL,
             status TEXT DEFAULT 'setup',
-            created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-            started_at TIMESTAMP NULL,
-            completed_at TIMESTAMP NULL
+            created_at INTEGER DEFAULT (strftime('%s', 'now')),
+            started_at INTEGER NULL,
+            completed_at INTEGER NULL
         )
     )";
 
-    if (!query.exec(createTournamentsTable))
+    if (!exec(query, createTournamentsTable))
     {
         qDebug() << "Failed to create tournaments table:" << query.lastError().text();
         return false;
     }
 
+    // Index the catalog's filter and sort columns
+    if (!exec(query, "CREATE INDEX IF NOT EXISTS idx_tournaments_created ON tournaments (created_at)") ||
+        !exec(query, "CREATE INDEX IF NOT EXISTS idx_tournaments_status_created ON tournaments (status, created_at)"))
+    {
+        qDebug() << "Failed to create tournaments indexes:" << query.lastError().text();
+        return false;
+    }
+
+    // Create maintenance log table, one row per runMaintenance() that did anything
+    QString createMaintenanceLogTable = R"(
+        CREATE TABLE IF NOT EXISTS maintenance_log (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            started_at INTEGER NOT NULL,
+            duration_ms INTEGER NOT NULL,
+            steps TEXT NOT NULL,
+            page_size INTEGER NOT NULL,
+            pages_before INTEGER NOT NULL,
+            pages_after INTEGER NOT NULL,
+            free_pages_after INTEGER NOT NULL,
+            finished INTEGER NOT NULL
+        )
+    )";
+
+    if (!exec(query, createMaintenanceLogTable))
+    {
+        qDebug() << "Failed to create maintenance log table:" << query.lastError().text();
+        return false;
+    }
+
+    // The split layout keeps these tables in each tournament's own file
+    if (!splitLayout && !createTournamentTables("main"))
+    {
+        return false;
+    }
+
+    // Files of deleted tournaments that another connection held open
+    if (splitLayout)
+    {
+        removeOrphanedTournamentFiles();
+    }
+
+    // Player search works without the full-text index, only slower
+    playerSearchIndex = createPlayerSearchIndex();
+    if (!playerSearchIndex)
+    {
+        qDebug() << "Player search index unavailable; searching names by scan";
+    }
+
+    return migrateSchema();
+}
+
+bool Database::isSplitLayout() const
+{
+    return splitLayout;
+}
+
+QString Database::getTournamentDirectory() const
+{
+    return tournamentDirectoryFor(dbPath);
+}
+
+QString Database::tournamentDirectoryFor(const QString &databasePath)
+{
+    QFileInfo info(databasePath);
+    return info.absoluteDir().filePath(info.completeBaseName() + "-tournaments");
+}
+
+QString Database::getTournamentFilePath(int tournamentId)
+{
+    OT_TRACE_SCOPE("Database::getTournamentFilePath");
+    QSqlQuery &query = cachedQuery("SELECT file FROM tournament_files WHERE tournament_id = ?");
+    QueryReset reset(query);
+    query.addBindValue(tournamentId);
+
+    if (!exec(query) || !next(query))
+    {
+        return QString();
+    }
+
+    return QDir(getTournamentDirectory()).filePath(query.value(0).toString());
+}
+
+QList<int> Database::getTournamentFileIds()
+{
+    OT_TRACE_SCOPE("Database::getTournamentFileIds");
+    QList<int> ids;
+    QSqlQuery &query = cachedQuery("SELECT tournament_id FROM tournament_files ORDER BY tournament_id");
+    QueryReset reset(query);
+
+    if (!exec(query))
+    {
+        qDebug() << "Failed to list tournament files:" << query.lastError().text();
+        return ids;
+    }
+
+    while (next(query))
+    {
+        ids.append(query.value(0).toInt());
+    }
+
+    return ids;
+}
+
+bool Database::attachTournament(int tournamentId)
+{
+    OT_TRACE_SCOPE("Database::attachTournament");
+    if (!splitLayout)
+    {
+        return true;
+    }
+
+    // Another connection may have deleted the tournament since its file was
+    // attached here, so the catalog is asked every time; a deleted file must
+    // be neither written to nor held open
+    QString path = getTournamentFilePath(tournamentId);
+    if (path.isEmpty())
+    {
+        qDebug() << "No file for tournament" << tournamentId;
+        if (tournamentId == attachedTournamentId && transactionDepth == 0)
+        {
+            detachTournament();
+        }
+        return false;
+    }
+
+    if (tournamentId == attachedTournamentId)
+    {
+        return true;
+    }
+
+    if (transactionDepth > 0)
+    {
+        qDebug() << "Cannot switch to tournament" << tournamentId << "inside a transaction";
+        return false;
+    }
+
+    if (!detachTournament())
+    {
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("ATTACH DATABASE ? AS event");
+    query.addBindValue(path);
+    if (!exec(query))
+    {
+        qDebug() << "Error attaching" << path << ":" << query.lastError().text();
+        return false;
+    }
+    attachedTournamentId = tournamentId;
+
+    // Read-only connections rely on the writer having created the tables
+    if (accessMode == ReadWrite &&
+        (!exec(query, "PRAGMA event.journal_mode = WAL") || !createTournamentTables("event")))
+    {
+        qDebug() << "Failed to prepare tournament file" << path;
+        return false;
+    }
+
+    return true;
+}
+
+bool Database::detachTournament()
+{
+    OT_TRACE_SCOPE("Database::detachTournament");
+    if (attachedTournamentId == -1)
+    {
+        return true;
+    }
+
+    // Cached statements are all reset between calls, so none holds the file open
+    QSqlQuery query(db);
+    if (!exec(query, "DETACH DATABASE event"))
+    {
+        qDebug() << "Error detaching tournament file:" << query.lastError().text();
+        return false;
+    }
+
+    attachedTournamentId = -1;
+    return true;
+}
+
+bool Database::removeTournamentFile(int tournamentId)
+{
+    OT_TRACE_SCOPE("Database::removeTournamentFile");
+    QString path = getTournamentFilePath(tournamentId);
+
+    if (attachedTournamentId == tournamentId && (transactionDepth > 0 || !detachTournament()))
+    {
+        qDebug() << "Cannot release the file of tournament" << tournamentId;
+        return false;
+    }
+
+    // Forget the file and the tournament together, then drop the file
+    QSqlQuery query(db);
+    if (!beginTransaction())
+    {
+        return false;
+    }
+
+    query.prepare("DELETE FROM tournament_files WHERE tournament_id = ?");
+    query.addBindValue(tournamentId);
+    bool ok = exec(query);
+
+    query.prepare("DELETE FROM tournaments WHERE id = ?");
+    query.addBindValue(tournamentId);
+    ok = ok && exec(query);
+    int removed = query.numRowsAffected();
+
+    if (!ok)
+    {
+        qDebug() << "Failed to delete tournament:" << query.lastError().text();
+        rollbackTransaction();
+        return false;
+    }
+
+    if (!commitTransaction())
+    {
+        qDebug() << "Failed to commit tournament deletion transaction:" << db.lastError().text();
+        return false;
+    }
+
+    // Other connections find the catalog entry gone and detach the file.
+    // One still holding it open keeps it from being deleted on Windows; the
+    // next connect() sweeps it up.
+    if (!path.isEmpty() && !removeDatabaseFile(path))
+    {
+        qDebug() << "Could not delete" << path << "yet; it is removed at the next start";
+    }
+
+    return removed > 0;
+}
+
+void Database::removeOrphanedTournamentFiles()
+{
+    OT_TRACE_SCOPE("Database::removeOrphanedTournamentFiles");
+    QSet<QString> listed;
+    QSqlQuery query(db);
+    if (!exec(query, "SELECT file FROM tournament_files"))
+    {
+        qDebug() << "Failed to list tournament files:" << query.lastError().text();
+        return;
+    }
+    while (next(query))
+    {
+        listed.insert(query.value(0).toString());
+    }
+    query.finish();
+
+    QDir directory(getTournamentDirectory());
+    for (const QString &file : directory.entryList(QStringList() << "tournament-*.db", QDir::Files))
+    {
+        if (!listed.contains(file) && removeDatabaseFile(directory.filePath(file)))
+        {
+            qDebug() << "Removed file of deleted tournament" << file;
+        }
+    }
+}
+
+bool Database::convertToSplitLayout()
+{
+    OT_TRACE_SCOPE("Database::convertToSplitLayout");
+    if (splitLayout)
+    {
+        return true;
+    }
+
+    if (isInMemory() || accessMode != ReadWrite || transactionDepth > 0)
+    {
+        qDebug() << "Only a file opened for writing can be split, outside a transaction";
+        return false;
+    }
+
+    QDir directory(getTournamentDirectory());
+    if (!directory.mkpath("."))
+    {
+        qDebug() << "Failed to create tournament directory" << directory.path();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    QList<int> ids;
+    if (!exec(query, "SELECT id FROM tournaments ORDER BY id"))
+    {
+        qDebug() << "Failed to list tournaments:" << query.lastError().text();
+        return false;
+    }
+    while (next(query))
+    {
+        ids.append(query.value(0).toInt());
+    }
+    query.finish();
+
+    // Matches go in before the roster, so the standings triggers in the new
+    // file total them up as each player is entered
+    const QStringList tables = {"matches", "match_id_sequence", "tournament_results", "player_tournaments"};
+
+    for (int id : ids)
+    {
+        // Start from a fresh file; one may be left over from a failed attempt
+        QString file = QString("tournament-%1.db").arg(id);
+        QString path = directory.filePath(file);
+        if (!removeDatabaseFile(path))
+        {
+            qDebug() << "Cannot replace leftover file" << path;
+            return false;
+        }
+
+        query.prepare("ATTACH DATABASE ? AS event");
+        query.addBindValue(path);
+        if (!exec(query))
+        {
+            qDebug() << "Error attaching" << path << ":" << query.lastError().text();
+            return false;
+        }
+
+        bool ok = exec(query, "PRAGMA event.journal_mode = WAL") && createTournamentTables("event") &&
+                  beginTransaction();
+        for (const QString &table : tables)
+        {
+            query.prepare(QString("INSERT INTO event.%1 SELECT * FROM main.%1 WHERE tournament_id = ?").arg(table));
+            query.addBindValue(id);
+            ok = ok && exec(query);
+        }
+
+        if (ok)
+        {
+            ok = commitTransaction();
+        }
+        else
+        {
+            qDebug() << "Failed to copy tournament" << id << ":" << query.lastError().text();
+            rollbackTransaction();
+        }
+
+        exec(query, "DETACH DATABASE event");
+        if (!ok)
+        {
+            return false;
+        }
+    }
+
+    // Only now does the catalog switch layout, in one transaction, so an
+    // interrupted conversion leaves the single file as it was
+    clearStatementCache();
+    beginTransaction();
+    bool ok = exec(query, "CREATE TABLE tournament_files (tournament_id INTEGER PRIMARY KEY, file TEXT NOT NULL)") &&
+              exec(query, "INSERT INTO tournament_files (tournament_id, file) "
+                          "SELECT id, 'tournament-' || id || '.db' FROM tournaments");
+    const QStringList droppedTables = {"player_standings", "player_tournaments", "tournament_results",
+                                       "match_id_sequence", "matches"};
+    for (const QString &table : droppedTables)
+    {
+        ok = ok && exec(query, QString("DROP TABLE main.%1").arg(table));
+    }
+
+    if (!ok)
+    {
+        qDebug() << "Failed to switch catalog layout:" << query.lastError().text();
+        rollbackTransaction();
+        return false;
+    }
+
+    if (!commitTransaction())
+    {
+        qDebug() << "Failed to commit catalog layout:" << db.lastError().text();
+        return false;
+    }
+
+    splitLayout = true;
+
+    // Give the space of the moved tables back to the file system
+    if (!exec(query, "VACUUM"))
+    {
+        qDebug() << "Failed to compact catalog:" << query.lastError().text();
+    }
+
+    return true;
+}
+
+bool Database::createTournamentTables(const QString &schema)
+{
+    OT_TRACE_SCOPE("Database::createTournamentTables");
+    QSqlQuery query(db);
+
     // Create matches table with tournament_id
-    QString createMatchesTable = R"(
-        CREATE TABLE IF NOT EXISTS matches (
+    QString createMatchesTable = QString(R"(
+        CREATE TABLE IF NOT EXISTS %1.matches (
             id INTEGER NOT NULL,
             tournament_id INTEGER NOT NULL,
             round INTEGER NOT NULL,
@@ -104,32 +1005,42 @@ bool Database::initializeSchema()
             FOREIGN KEY (p1) REFERENCES players(id),
             FOREIGN KEY (p2) REFERENCES players(id)
         )
-    )";
+    )")
+        .arg(schema);
 
-    if (!query.exec(createMatchesTable))
+    if (!exec(query, createMatchesTable))
     {
         qDebug() << "Failed to create matches table:" << query.lastError().text();
         return false;
     }
 
+    // The primary key leads with the match id, so per-tournament reads and
+    // the player_standings triggers need their own index
+    if (!exec(query, QString("CREATE INDEX IF NOT EXISTS %1.idx_matches_tournament_round ON matches (tournament_id, round)").arg(schema)))
+    {
+        qDebug() << "Failed to create matches index:" << query.lastError().text();
+        return false;
+    }
+
     // Create match_id_sequence table to track next match ID for each tournament
-    QString createMatchIdSequenceTable = R"(
-        CREATE TABLE IF NOT EXISTS match_id_sequence (
+    QString createMatchIdSequenceTable = QString(R"(
+        CREATE TABLE IF NOT EXISTS %1.match_id_sequence (
             tournament_id INTEGER PRIMARY KEY,
             next_id INTEGER NOT NULL DEFAULT 1,
             FOREIGN KEY (tournament_id) REFERENCES tournaments(id)
         )
-    )";
+    )")
+        .arg(schema);
 
-    if (!query.exec(createMatchIdSequenceTable))
+    if (!exec(query, createMatchIdSequenceTable))
     {
         qDebug() << "Failed to create match_id_sequence table:" << query.lastError().text();
         return false;
     }
 
     // Create tournament_results table to store completed tournament data
-    QString createTournamentResultsTable = R"(
-        CREATE TABLE IF NOT EXISTS tournament_results (
+    QString createTournamentResultsTable = QString(R"(
+        CREATE TABLE IF NOT EXISTS %1.tournament_results (
             id INTEGER PRIMARY KEY AUTOINCREMENT,
             tournament_id INTEGER NOT NULL,
             player_id INTEGER NOT NULL,
@@ -146,29 +1057,188 @@ bool Database::initializeSchema()
             FOREIGN KEY (tournament_id) REFERENCES tournaments(id),
             FOREIGN KEY (player_id) REFERENCES players(id)
         )
-    )";
+    )")
+        .arg(schema);
 
-    if (!query.exec(createTournamentResultsTable))
+    if (!exec(query, createTournamentResultsTable))
     {
         qDebug() << "Failed to create tournament_results table:" << query.lastError().text();
         return false;
     }
 
     // Create player_tournaments linking table
-    QString createPlayerTournamentsTable = R"(
-        CREATE TABLE IF NOT EXISTS player_tournaments (
+    QString createPlayerTournamentsTable = QString(R"(
+        CREATE TABLE IF NOT EXISTS %1.player_tournaments (
             player_id INTEGER NOT NULL,
             tournament_id INTEGER NOT NULL,
             PRIMARY KEY (player_id, tournament_id),
             FOREIGN KEY (player_id) REFERENCES players(id) ON DELETE CASCADE,
             FOREIGN KEY (tournament_id) REFERENCES tournaments(id) ON DELETE CASCADE
         )
-    )";
+    )")
+        .arg(schema);
+
+    if (!exec(query, createPlayerTournamentsTable))
+    {
+        qDebug() << "Failed to create player_tournaments table:" << query.lastError().text();
+        return false;
+    }
+
+    // Create player_standings table: running totals per registered player,
+    // kept current by the triggers below so readers need no match scan
+    QString createPlayerStandingsTable = QString(R"(
+        CREATE TABLE IF NOT EXISTS %1.player_standings (
+            tournament_id INTEGER NOT NULL,
+            player_id INTEGER NOT NULL,
+            half_points INTEGER NOT NULL DEFAULT 0,
+            wins INTEGER NOT NULL DEFAULT 0,
+            losses INTEGER NOT NULL DEFAULT 0,
+            draws INTEGER NOT NULL DEFAULT 0,
+            games INTEGER NOT NULL DEFAULT 0,
+            PRIMARY KEY (tournament_id, player_id)
+        )
+    )")
+        .arg(schema);
+
+    if (!exec(query, createPlayerStandingsTable) ||
+        !exec(query, QString("CREATE INDEX IF NOT EXISTS %1.idx_player_standings_rank ON player_standings (tournament_id, half_points DESC)").arg(schema)))
+    {
+        qDebug() << "Failed to create player_standings table:" << query.lastError().text();
+        return false;
+    }
+
+    const QStringList standingsTriggers = {
+        "CREATE TRIGGER IF NOT EXISTS %1.player_standings_link_insert AFTER INSERT ON player_tournaments BEGIN " +
+            refreshStandingsSql("pt.tournament_id = NEW.tournament_id AND pt.player_id = NEW.player_id") + " END",
+        "CREATE TRIGGER IF NOT EXISTS %1.player_standings_link_delete AFTER DELETE ON player_tournaments BEGIN "
+        "DELETE FROM player_standings WHERE tournament_id = OLD.tournament_id AND player_id = OLD.player_id; END",
+        "CREATE TRIGGER IF NOT EXISTS %1.player_standings_match_insert AFTER INSERT ON matches BEGIN " +
+            standingsDeltaSql("NEW", "+") + " END",
+        "CREATE TRIGGER IF NOT EXISTS %1.player_standings_match_update AFTER UPDATE OF tournament_id, p1, p2, result ON matches "
+        "WHEN OLD.result IS NOT NEW.result OR OLD.p1 IS NOT NEW.p1 OR OLD.p2 IS NOT NEW.p2 "
+        "OR OLD.tournament_id IS NOT NEW.tournament_id BEGIN " +
+            standingsDeltaSql("OLD", "-") + standingsDeltaSql("NEW", "+") + " END",
+        "CREATE TRIGGER IF NOT EXISTS %1.player_standings_match_delete AFTER DELETE ON matches BEGIN " +
+            standingsDeltaSql("OLD", "-") + " END"};
+
+    for (const QString &trigger : standingsTriggers)
+    {
+        if (!exec(query, QString(trigger).arg(schema)))
+        {
+            qDebug() << "Failed to create player_standings triggers:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Database::createPlayerSearchIndex()
+{
+    OT_TRACE_SCOPE("Database::createPlayerSearchIndex");
+    QSqlQuery query(db);
+    if (!exec(query, "SELECT 1 FROM sqlite_master WHERE name = 'players_fts'"))
+    {
+        return false;
+    }
+    if (next(query))
+    {
+        return true;
+    }
+    query.finish();
+
+    // Trigram index over player names, kept in step with players by
+    // triggers. It needs SQLite 3.34 or later built with FTS5; the index is
+    // filled from players whenever it is first created.
+    const QStringList statements = {
+        "CREATE VIRTUAL TABLE players_fts USING fts5(name, content='players', content_rowid='id', tokenize='trigram')",
+        "CREATE TRIGGER players_fts_insert AFTER INSERT ON players BEGIN "
+        "INSERT INTO players_fts (rowid, name) VALUES (NEW.id, NEW.name); END",
+        "CREATE TRIGGER players_fts_delete AFTER DELETE ON players BEGIN "
+        "INSERT INTO players_fts (players_fts, rowid, name) VALUES ('delete', OLD.id, OLD.name); END",
+        "CREATE TRIGGER players_fts_update AFTER UPDATE OF name ON players BEGIN "
+        "INSERT INTO players_fts (players_fts, rowid, name) VALUES ('delete', OLD.id, OLD.name); "
+        "INSERT INTO players_fts (rowid, name) VALUES (NEW.id, NEW.name); END",
+        "INSERT INTO players_fts (players_fts) VALUES ('rebuild')"};
+
+    beginTransaction();
+    for (const QString &statement : statements)
+    {
+        if (!exec(query, statement))
+        {
+            qDebug() << "Failed to create player search index:" << query.lastError().text();
+            rollbackTransaction();
+            return false;
+        }
+    }
+
+    return commitTransaction();
+}
+
+bool Database::migrateSchema()
+{
+    OT_TRACE_SCOPE("Database::migrateSchema");
+    QSqlQuery query(db);
+    if (!exec(query, "PRAGMA user_version") || !next(query))
+    {
+        qDebug() << "Failed to read schema version:" << query.lastError().text();
+        return false;
+    }
+
+    int version = query.value(0).toInt();
+    query.finish();
+
+    // Version 1: tournament timestamps are stored as integer epoch seconds
+    if (version < 1)
+    {
+        beginTransaction();
+
+        const QStringList columns = {"created_at", "started_at", "completed_at"};
+        for (const QString &column : columns)
+        {
+            QString convert = QString("UPDATE tournaments SET %1 = CAST(strftime('%s', %1) AS INTEGER) "
+                                      "WHERE typeof(%1) = 'text'")
+                                  .arg(column);
+            if (!exec(query, convert))
+            {
+                qDebug() << "Failed to convert tournament timestamps:" << query.lastError().text();
+                rollbackTransaction();
+                return false;
+            }
+        }
+
+        if (!exec(query, "PRAGMA user_version = 1"))
+        {
+            qDebug() << "Failed to update schema version:" << query.lastError().text();
+            rollbackTransaction();
+            return false;
+        }
 
-    if (!query.exec(createPlayerTournamentsTable))
+        if (!commitTransaction())
+        {
+            qDebug() << "Failed to commit schema migration:" << db.lastError().text();
+            return false;
+        }
+    }
+
+    // Version 2: player_standings is filled in for existing tournaments.
+    // Split catalogs are only made from version 2 files, so have nothing to fill.
+    if (version < 2)
     {
-        qDebug() << "Failed to create player_tournaments table:" << query.lastError().text();
-        return false;
+        beginTransaction();
+
+        if ((!splitLayout && !exec(query, refreshStandingsSql("1"))) || !exec(query, "PRAGMA user_version = 2"))
+        {
+            qDebug() << "Failed to fill player standings:" << query.lastError().text();
+            rollbackTransaction();
+            return false;
+        }
+
+        if (!commitTransaction())
+        {
+            qDebug() << "Failed to commit schema migration:" << db.lastError().text();
+            return false;
+        }
     }
 
     return true;
@@ -177,12 +1247,13 @@ bool Database::initializeSchema()
 // Player operations
 int Database::addPlayer(const QString &name, int seed)
 {
+    OT_TRACE_SCOPE("Database::addPlayer");
     QSqlQuery query(db);
     query.prepare("INSERT INTO players (name, seed) VALUES (?, ?)");
     query.addBindValue(name);
     query.addBindValue(seed);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to add player:" << query.lastError().text();
         return -1;
@@ -193,49 +1264,57 @@ int Database::addPlayer(const QString &name, int seed)
 
 int Database::addPlayerToTournament(const QString &name, int tournamentId, int seed)
 {
+    OT_TRACE_SCOPE("Database::addPlayerToTournament");
+    if (!attachTournament(tournamentId))
+    {
+        return -1;
+    }
+
     // Begin transaction for atomicity
-    db.transaction();
+    beginTransaction();
 
     // Add player to players table
-    QSqlQuery query(db);
-    query.prepare("INSERT OR IGNORE INTO players (name, seed) VALUES (?, ?)");
-    query.addBindValue(name);
-    query.addBindValue(seed);
+    QSqlQuery &insertQuery = cachedQuery("INSERT OR IGNORE INTO players (name, seed) VALUES (?, ?)");
+    QueryReset insertReset(insertQuery);
+    insertQuery.addBindValue(name);
+    insertQuery.addBindValue(seed);
 
-    if (!query.exec())
+    if (!exec(insertQuery))
     {
-        qDebug() << "Failed to add player:" << query.lastError().text();
-        db.rollback();
+        qDebug() << "Failed to add player:" << insertQuery.lastError().text();
+        rollbackTransaction();
         return -1;
     }
 
     // Get the player ID (either newly inserted or existing)
-    query.prepare("SELECT id FROM players WHERE name = ?");
-    query.addBindValue(name);
+    QSqlQuery &idQuery = cachedQuery("SELECT id FROM players WHERE name = ?");
+    QueryReset idReset(idQuery);
+    idQuery.addBindValue(name);
 
-    if (!query.exec() || !query.next())
+    if (!exec(idQuery) || !next(idQuery))
     {
-        qDebug() << "Failed to get player ID:" << query.lastError().text();
-        db.rollback();
+        qDebug() << "Failed to get player ID:" << idQuery.lastError().text();
+        rollbackTransaction();
         return -1;
     }
 
-    int playerId = query.value(0).toInt();
+    int playerId = idQuery.value(0).toInt();
 
     // Associate player with tournament
-    query.prepare("INSERT OR IGNORE INTO player_tournaments (player_id, tournament_id) VALUES (?, ?)");
-    query.addBindValue(playerId);
-    query.addBindValue(tournamentId);
+    QSqlQuery &linkQuery = cachedQuery("INSERT OR IGNORE INTO player_tournaments (player_id, tournament_id) VALUES (?, ?)");
+    QueryReset linkReset(linkQuery);
+    linkQuery.addBindValue(playerId);
+    linkQuery.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(linkQuery))
     {
-        qDebug() << "Failed to associate player with tournament:" << query.lastError().text();
-        db.rollback();
+        qDebug() << "Failed to associate player with tournament:" << linkQuery.lastError().text();
+        rollbackTransaction();
         return -1;
     }
 
     // Commit transaction
-    if (!db.commit())
+    if (!commitTransaction())
     {
         qDebug() << "Failed to commit add player transaction:" << db.lastError().text();
         return -1;
@@ -244,19 +1323,240 @@ int Database::addPlayerToTournament(const QString &name, int tournamentId, int s
     return playerId;
 }
 
+RosterImportResult Database::importRoster(int tournamentId, const std::function<bool(RosterEntry &)> &nextEntry)
+{
+    OT_TRACE_SCOPE("Database::importRoster");
+    if (!attachTournament(tournamentId))
+    {
+        return RosterImportResult();
+    }
+
+    RosterImportResult result;
+
+    // The roster is staged in a temporary table, so existing players are
+    // found and new ones inserted with one statement each instead of a
+    // lookup per name. The unique name column catches duplicate lines.
+    QSqlQuery query(db);
+    if (!exec(query, "CREATE TEMP TABLE IF NOT EXISTS roster_import (name TEXT PRIMARY KEY, seed INTEGER NOT NULL)"))
+    {
+        qDebug() << "Failed to create roster staging table:" << query.lastError().text();
+        return result;
+    }
+
+    if (!beginTransaction())
+    {
+        qDebug() << "Failed to begin roster import transaction:" << db.lastError().text();
+        return result;
+    }
+
+    if (!exec(query, "DELETE FROM temp.roster_import"))
+    {
+        qDebug() << "Failed to clear roster staging table:" << query.lastError().text();
+        rollbackTransaction();
+        return result;
+    }
+
+    QSqlQuery &stageQuery = cachedQuery("INSERT OR IGNORE INTO temp.roster_import (name, seed) VALUES (?, ?)");
+    QueryReset stageReset(stageQuery);
+    RosterEntry entry;
+    while (nextEntry(entry))
+    {
+        stageQuery.bindValue(0, entry.name);
+        stageQuery.bindValue(1, entry.seed);
+
+        if (!exec(stageQuery))
+        {
+            qDebug() << "Failed to stage roster entry:" << stageQuery.lastError().text();
+            rollbackTransaction();
+            return result;
+        }
+
+        if (stageQuery.numRowsAffected() == 0)
+        {
+            result.duplicates.append(entry.name);
+        }
+    }
+
+    // Sort the staged names that are already in the registry into
+    // returning players and players already in this tournament
+    QSqlQuery &existingQuery = cachedQuery("SELECT r.name, pt.player_id IS NOT NULL FROM temp.roster_import r "
+                                           "JOIN players p ON p.name = r.name "
+                                           "LEFT JOIN player_tournaments pt ON pt.player_id = p.id AND pt.tournament_id = ? "
+                                           "ORDER BY r.rowid");
+    QueryReset existingReset(existingQuery);
+    existingQuery.addBindValue(tournamentId);
+
+    if (!exec(existingQuery))
+    {
+        qDebug() << "Failed to resolve roster players:" << existingQuery.lastError().text();
+        rollbackTransaction();
+        return result;
+    }
+
+    while (next(existingQuery))
+    {
+        if (existingQuery.value(1).toBool())
+        {
+            result.alreadyRegistered.append(existingQuery.value(0).toString());
+        }
+        else
+        {
+            ++result.returning;
+        }
+    }
+    existingQuery.finish();
+
+    // Create the new players in roster order, then enter everyone
+    QSqlQuery &insertQuery = cachedQuery("INSERT OR IGNORE INTO players (name, seed) "
+                                         "SELECT name, seed FROM temp.roster_import ORDER BY rowid");
+    QueryReset insertReset(insertQuery);
+    if (!exec(insertQuery))
+    {
+        qDebug() << "Failed to add roster players:" << insertQuery.lastError().text();
+        rollbackTransaction();
+        return result;
+    }
+    result.added = insertQuery.numRowsAffected();
+
+    QSqlQuery &linkQuery = cachedQuery("INSERT OR IGNORE INTO player_tournaments (player_id, tournament_id) "
+                                       "SELECT p.id, ? FROM temp.roster_import r JOIN players p ON p.name = r.name "
+                                       "ORDER BY r.rowid");
+    QueryReset linkReset(linkQuery);
+    linkQuery.addBindValue(tournamentId);
+
+    if (!exec(linkQuery))
+    {
+        qDebug() << "Failed to associate roster players with tournament:" << linkQuery.lastError().text();
+        rollbackTransaction();
+        return result;
+    }
+
+    if (!commitTransaction())
+    {
+        qDebug() << "Failed to commit roster import transaction:" << db.lastError().text();
+        return result;
+    }
+
+    result.ok = true;
+    return result;
+}
+
+QList<Player> Database::searchPlayers(const QString &text, int limit)
+{
+    OT_TRACE_SCOPE("Database::searchPlayers");
+    QList<Player> players;
+    QSet<int> found;
+    const QString needle = text.simplified();
+    if (needle.isEmpty() || limit <= 0)
+    {
+        return players;
+    }
+
+    // Append the rows not found yet that the filter, if any, accepts
+    auto readPlayers = [this, &players, &found, limit](QSqlQuery &query, const std::function<bool(const QString &)> &accept)
+    {
+        while (players.size() < limit && next(query))
+        {
+            int id = query.value(0).toInt();
+            QString name = query.value(1).toString();
+            if (!found.contains(id) && (!accept || accept(name)))
+            {
+                found.insert(id);
+                players.append(Player(id, name, query.value(2).toInt()));
+            }
+        }
+    };
+
+    // The trigram index needs at least three characters to match anything
+    if (playerSearchIndex && needle.size() >= 3)
+    {
+        QSqlQuery &query = cachedQuery("SELECT p.id, p.name, p.seed FROM players_fts f JOIN players p ON p.id = f.rowid "
+                                       "WHERE players_fts MATCH ? ORDER BY f.rank LIMIT ?");
+        QueryReset reset(query);
+
+        // A quoted phrase matches names containing the whole text
+        QString phrase = needle;
+        query.bindValue(0, "\"" + phrase.replace("\"", "\"\"") + "\"");
+        query.bindValue(1, limit);
+
+        if (exec(query))
+        {
+            readPlayers(query, nullptr);
+            query.finish();
+
+            // Fill up with names sharing the text's trigrams, most shared
+            // first. Names sharing under half of them are too far off.
+            QStringList trigrams;
+            QStringList terms;
+            for (int i = 0; i + 3 <= needle.size(); ++i)
+            {
+                QString trigram = needle.mid(i, 3).toLower();
+                if (!trigrams.contains(trigram))
+                {
+                    trigrams.append(trigram);
+                    terms.append("\"" + QString(trigram).replace("\"", "\"\"") + "\"");
+                }
+            }
+
+            query.bindValue(0, terms.join(" OR "));
+            query.bindValue(1, limit * 4);
+            if (players.size() < limit && exec(query))
+            {
+                readPlayers(query, [&trigrams](const QString &name)
+                            {
+                    const QString lowerName = name.toLower();
+                    int shared = 0;
+                    for (const QString &trigram : trigrams)
+                    {
+                        shared += lowerName.contains(trigram) ? 1 : 0;
+                    }
+                    return shared * 2 >= trigrams.size(); });
+            }
+
+            return players;
+        }
+
+        // A file indexed by an SQLite with FTS5 but opened by one without;
+        // don't try to prepare the query again on every keystroke
+        qDebug() << "Player search index unusable; searching names by scan:" << query.lastError().text();
+        playerSearchIndex = false;
+    }
+
+    // Short text, or no full-text index: scan the names, prefixes first
+    QString pattern = needle;
+    pattern.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+
+    QSqlQuery &query = cachedQuery("SELECT id, name, seed FROM players WHERE name LIKE ? ESCAPE '\\' "
+                                   "ORDER BY name LIKE ? ESCAPE '\\' DESC, name LIMIT ?");
+    QueryReset reset(query);
+    query.bindValue(0, "%" + pattern + "%");
+    query.bindValue(1, pattern + "%");
+    query.bindValue(2, limit);
+
+    if (!exec(query))
+    {
+        qDebug() << "Failed to search players:" << query.lastError().text();
+        return players;
+    }
+
+    readPlayers(query, nullptr);
+    return players;
+}
+
 QList<Player> Database::getAllPlayers()
 {
+    OT_TRACE_SCOPE("Database::getAllPlayers");
     QList<Player> players;
     QSqlQuery query(db);
     query.prepare("SELECT id, name, seed FROM players ORDER BY name");
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to get players:" << query.lastError().text();
         return players;
     }
 
-    while (query.next())
+    while (next(query))
     {
         int id = query.value(0).toInt();
         QString name = query.value(1).toString();
@@ -269,11 +1569,12 @@ QList<Player> Database::getAllPlayers()
 
 Player Database::getPlayerById(int id)
 {
-    QSqlQuery query(db);
-    query.prepare("SELECT id, name, seed FROM players WHERE id = ?");
+    OT_TRACE_SCOPE("Database::getPlayerById");
+    QSqlQuery &query = cachedQuery("SELECT id, name, seed FROM players WHERE id = ?");
+    QueryReset reset(query);
     query.addBindValue(id);
 
-    if (!query.exec() || !query.next())
+    if (!exec(query) || !next(query))
     {
         qDebug() << "Failed to get player by ID:" << query.lastError().text();
         return Player(); // Return default player
@@ -286,13 +1587,14 @@ Player Database::getPlayerById(int id)
 
 bool Database::updatePlayer(const Player &player)
 {
-    QSqlQuery query(db);
-    query.prepare("UPDATE players SET name = ?, seed = ? WHERE id = ?");
+    OT_TRACE_SCOPE("Database::updatePlayer");
+    QSqlQuery &query = cachedQuery("UPDATE players SET name = ?, seed = ? WHERE id = ?");
+    QueryReset reset(query);
     query.addBindValue(player.getName());
     query.addBindValue(player.getSeed());
     query.addBindValue(player.getId());
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to update player:" << query.lastError().text();
         return false;
@@ -303,10 +1605,11 @@ bool Database::updatePlayer(const Player &player)
 
 bool Database::deletePlayer(int id)
 {
+    OT_TRACE_SCOPE("Database::deletePlayer");
     QSqlQuery query(db);
 
     // Begin transaction for atomicity
-    db.transaction();
+    beginTransaction();
 
     // Check how many tournaments this player is in
     int tournamentCount = getPlayerTournamentCount(id);
@@ -315,31 +1618,32 @@ bool Database::deletePlayer(int id)
     query.prepare("DELETE FROM player_tournaments WHERE player_id = ?");
     query.addBindValue(id);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete player tournament associations:" << query.lastError().text();
-        db.rollback();
+        rollbackTransaction();
         return false;
     }
 
     // If player is not in any tournaments, delete the player itself
     // Note: With CASCADE DELETE, the player would be automatically deleted when removed from all tournaments
-    // But we're not using CASCADE DELETE on players to allow players to exist without tournaments
-    if (tournamentCount == 0)
+    // But we're not using CASCADE DELETE on players to allow players to exist without tournaments.
+    // In the split layout only the attached tournament is counted, so the registry keeps the player.
+    if (tournamentCount == 0 && !splitLayout)
     {
         query.prepare("DELETE FROM players WHERE id = ?");
         query.addBindValue(id);
 
-        if (!query.exec())
+        if (!exec(query))
         {
             qDebug() << "Failed to delete player:" << query.lastError().text();
-            db.rollback();
+            rollbackTransaction();
             return false;
         }
     }
 
     // Commit transaction
-    if (!db.commit())
+    if (!commitTransaction())
     {
         qDebug() << "Failed to commit player deletion transaction:" << db.lastError().text();
         return false;
@@ -351,12 +1655,18 @@ bool Database::deletePlayer(int id)
 // Player-tournament operations
 bool Database::addPlayerToTournament(int playerId, int tournamentId)
 {
-    QSqlQuery query(db);
-    query.prepare("INSERT OR IGNORE INTO player_tournaments (player_id, tournament_id) VALUES (?, ?)");
+    OT_TRACE_SCOPE("Database::addPlayerToTournament");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
+    QSqlQuery &query = cachedQuery("INSERT OR IGNORE INTO player_tournaments (player_id, tournament_id) VALUES (?, ?)");
+    QueryReset reset(query);
     query.addBindValue(playerId);
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to add player tournament:" << query.lastError().text();
         return false;
@@ -367,12 +1677,18 @@ bool Database::addPlayerToTournament(int playerId, int tournamentId)
 
 bool Database::removePlayerFromTournament(int playerId, int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::removePlayerFromTournament");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
     QSqlQuery query(db);
     query.prepare("DELETE FROM player_tournaments WHERE player_id = ? AND tournament_id = ?");
     query.addBindValue(playerId);
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to remove player from tournament:" << query.lastError().text();
         return false;
@@ -383,20 +1699,49 @@ bool Database::removePlayerFromTournament(int playerId, int tournamentId)
 
 QList<Player> Database::getPlayersForTournament(int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::getPlayersForTournament");
+    if (!attachTournament(tournamentId))
+    {
+        return QList<Player>();
+    }
+
     QList<Player> players;
-    QSqlQuery query(db);
-    query.prepare("SELECT p.id, p.name, p.seed FROM players p "
-                  "JOIN player_tournaments pt ON p.id = pt.player_id "
-                  "WHERE pt.tournament_id = ? ORDER BY p.name");
+    const QString sql = "SELECT p.id, p.name, p.seed FROM players p "
+                        "JOIN player_tournaments pt ON p.id = pt.player_id "
+                        "WHERE pt.tournament_id = ? ORDER BY p.name";
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    if (sqlite3 *handle = nativeHandle())
+    {
+        QElapsedTimer timer;
+        timer.start();
+        NativeStatement statement(nativeStatement(handle, sql));
+        statement.bind(1, tournamentId);
+        while (statement.step())
+        {
+            players.append(Player(statement.intValue(0), statement.textValue(1), statement.intValue(2)));
+        }
+        recordNativeStatement(sql, timer.nsecsElapsed(), players.size());
+
+        if (statement.isDone())
+        {
+            return players;
+        }
+        players.clear(); // Retry through QtSql
+    }
+#endif
+
+    QSqlQuery &query = cachedQuery(sql);
+    QueryReset reset(query);
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to get players for tournament:" << query.lastError().text();
         return players;
     }
 
-    while (query.next())
+    while (next(query))
     {
         int id = query.value(0).toInt();
         QString name = query.value(1).toString();
@@ -409,27 +1754,34 @@ QList<Player> Database::getPlayersForTournament(int tournamentId)
 
 bool Database::isPlayerInTournament(int playerId, int tournamentId)
 {
-    QSqlQuery query(db);
-    query.prepare("SELECT 1 FROM player_tournaments WHERE player_id = ? AND tournament_id = ?");
+    OT_TRACE_SCOPE("Database::isPlayerInTournament");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
+    QSqlQuery &query = cachedQuery("SELECT 1 FROM player_tournaments WHERE player_id = ? AND tournament_id = ?");
+    QueryReset reset(query);
     query.addBindValue(playerId);
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to check if player is in tournament:" << query.lastError().text();
         return false;
     }
 
-    return query.next(); // Returns true if a row was found
+    return next(query); // Returns true if a row was found
 }
 
 int Database::getPlayerTournamentCount(int playerId)
 {
-    QSqlQuery query(db);
-    query.prepare("SELECT COUNT(*) FROM player_tournaments WHERE player_id = ?");
+    OT_TRACE_SCOPE("Database::getPlayerTournamentCount");
+    QSqlQuery &query = cachedQuery("SELECT COUNT(*) FROM player_tournaments WHERE player_id = ?");
+    QueryReset reset(query);
     query.addBindValue(playerId);
 
-    if (!query.exec() || !query.next())
+    if (!exec(query) || !next(query))
     {
         qDebug() << "Failed to get player tournament count:" << query.lastError().text();
         return 0;
@@ -441,62 +1793,70 @@ int Database::getPlayerTournamentCount(int playerId)
 // Match operations
 int Database::addMatch(int tournamentId, int round, int p1, int p2)
 {
-    QSqlQuery query(db);
+    OT_TRACE_SCOPE("Database::addMatch");
+    if (!attachTournament(tournamentId))
+    {
+        return -1;
+    }
 
     // Begin transaction for atomicity
-    db.transaction();
+    beginTransaction();
 
     // Get the next match ID for this tournament
     int nextMatchId = 1;
-    query.prepare("SELECT next_id FROM match_id_sequence WHERE tournament_id = ?");
-    query.addBindValue(tournamentId);
+    QSqlQuery &sequenceQuery = cachedQuery("SELECT next_id FROM match_id_sequence WHERE tournament_id = ?");
+    QueryReset sequenceReset(sequenceQuery);
+    sequenceQuery.addBindValue(tournamentId);
 
-    if (query.exec() && query.next())
+    if (exec(sequenceQuery) && next(sequenceQuery))
     {
         // Tournament exists in sequence table, get next ID
-        nextMatchId = query.value(0).toInt();
+        nextMatchId = sequenceQuery.value(0).toInt();
     }
     else
     {
         // Tournament doesn't exist in sequence table, check if there are existing matches
-        query.prepare("SELECT COALESCE(MAX(id), 0) + 1 FROM matches WHERE tournament_id = ?");
-        query.addBindValue(tournamentId);
+        QSqlQuery &maxQuery = cachedQuery("SELECT COALESCE(MAX(id), 0) + 1 FROM matches WHERE tournament_id = ?");
+        QueryReset maxReset(maxQuery);
+        maxQuery.addBindValue(tournamentId);
 
-        if (query.exec() && query.next())
+        if (exec(maxQuery) && next(maxQuery))
         {
-            nextMatchId = query.value(0).toInt();
+            nextMatchId = maxQuery.value(0).toInt();
         }
     }
 
     // Insert the match with the calculated ID
-    query.prepare("INSERT INTO matches (id, tournament_id, round, p1, p2) VALUES (?, ?, ?, ?, ?)");
-    query.addBindValue(nextMatchId);
-    query.addBindValue(tournamentId);
-    query.addBindValue(round);
-    query.addBindValue(p1);
-    query.addBindValue(p2);
-
-    if (!query.exec())
-    {
-        qDebug() << "Failed to add match:" << query.lastError().text();
-        db.rollback();
+    QSqlQuery &insertQuery = cachedQuery("INSERT INTO matches (id, tournament_id, round, p1, p2) VALUES (?, ?, ?, ?, ?)");
+    QueryReset insertReset(insertQuery);
+    insertQuery.addBindValue(nextMatchId);
+    insertQuery.addBindValue(tournamentId);
+    insertQuery.addBindValue(round);
+    insertQuery.addBindValue(p1);
+    insertQuery.addBindValue(p2);
+
+    if (!exec(insertQuery))
+    {
+        qDebug() << "Failed to add match:" << insertQuery.lastError().text();
+        rollbackTransaction();
         return -1;
     }
 
     // Update the next ID for this tournament
-    query.prepare("INSERT OR REPLACE INTO match_id_sequence (tournament_id, next_id) VALUES (?, ?)");
-    query.addBindValue(tournamentId);
-    query.addBindValue(nextMatchId + 1);
+    QSqlQuery &updateQuery = cachedQuery("INSERT OR REPLACE INTO match_id_sequence (tournament_id, next_id) VALUES (?, ?)");
+    QueryReset updateReset(updateQuery);
+    updateQuery.addBindValue(tournamentId);
+    updateQuery.addBindValue(nextMatchId + 1);
 
-    if (!query.exec())
+    if (!exec(updateQuery))
     {
-        qDebug() << "Failed to update match ID sequence:" << query.lastError().text();
-        db.rollback();
+        qDebug() << "Failed to update match ID sequence:" << updateQuery.lastError().text();
+        rollbackTransaction();
         return -1;
     }
 
     // Commit transaction
-    if (!db.commit())
+    if (!commitTransaction())
     {
         qDebug() << "Failed to commit transaction:" << db.lastError().text();
         return -1;
@@ -507,19 +1867,25 @@ int Database::addMatch(int tournamentId, int round, int p1, int p2)
 
 QList<Match> Database::getMatchesForRound(int tournamentId, int round)
 {
+    OT_TRACE_SCOPE("Database::getMatchesForRound");
+    if (!attachTournament(tournamentId))
+    {
+        return QList<Match>();
+    }
+
     QList<Match> matches;
-    QSqlQuery query(db);
-    query.prepare("SELECT id, tournament_id, round, p1, p2, result, locked FROM matches WHERE tournament_id = ? AND round = ? ORDER BY id");
+    QSqlQuery &query = cachedQuery("SELECT id, tournament_id, round, p1, p2, result, locked FROM matches WHERE tournament_id = ? AND round = ? ORDER BY id");
+    QueryReset reset(query);
     query.addBindValue(tournamentId);
     query.addBindValue(round);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to get matches for round:" << query.lastError().text();
         return matches;
     }
 
-    while (query.next())
+    while (next(query))
     {
         int id = query.value(0).toInt();
         int tournamentId = query.value(1).toInt();
@@ -536,28 +1902,69 @@ QList<Match> Database::getMatchesForRound(int tournamentId, int round)
 
 QList<Match> Database::getAllMatches(int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::getAllMatches");
     QList<Match> matches;
-    QSqlQuery query(db);
 
-    if (tournamentId == -1)
+    // Every tournament file in turn in the split layout
+    if (tournamentId == -1 && splitLayout)
     {
-        // Get all matches
-        query.prepare("SELECT id, tournament_id, round, p1, p2, result, locked FROM matches ORDER BY round, id");
+        for (int id : getTournamentFileIds())
+        {
+            matches.append(getAllMatches(id));
+        }
+        return matches;
     }
-    else
+
+    if (!attachTournament(tournamentId))
+    {
+        return matches;
+    }
+
+    // All matches, or those of a specific tournament
+    const QString sql = tournamentId == -1
+                            ? "SELECT id, tournament_id, round, p1, p2, result, locked FROM matches ORDER BY round, id"
+                            : "SELECT id, tournament_id, round, p1, p2, result, locked FROM matches WHERE tournament_id = ? ORDER BY round, id";
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    if (sqlite3 *handle = nativeHandle())
+    {
+        QElapsedTimer timer;
+        timer.start();
+        NativeStatement statement(nativeStatement(handle, sql));
+        if (tournamentId != -1)
+        {
+            statement.bind(1, tournamentId);
+        }
+        while (statement.step())
+        {
+            matches.append(Match(statement.intValue(0), statement.intValue(1), statement.intValue(2),
+                                 statement.intValue(3), statement.intValue(4), statement.textValue(5),
+                                 statement.intValue(6) != 0));
+        }
+        recordNativeStatement(sql, timer.nsecsElapsed(), matches.size());
+
+        if (statement.isDone())
+        {
+            return matches;
+        }
+        matches.clear(); // Retry through QtSql
+    }
+#endif
+
+    QSqlQuery &query = cachedQuery(sql);
+    QueryReset reset(query);
+    if (tournamentId != -1)
     {
-        // Get matches for specific tournament
-        query.prepare("SELECT id, tournament_id, round, p1, p2, result, locked FROM matches WHERE tournament_id = ? ORDER BY round, id");
         query.addBindValue(tournamentId);
     }
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to get all matches:" << query.lastError().text();
         return matches;
     }
 
-    while (query.next())
+    while (next(query))
     {
         int id = query.value(0).toInt();
         int tournamentId = query.value(1).toInt();
@@ -572,106 +1979,310 @@ QList<Match> Database::getAllMatches(int tournamentId)
     return matches;
 }
 
-bool Database::updateMatchResult(int matchId, const QString &result)
+int Database::forEachMatch(int tournamentId, const std::function<bool(const MatchRecord &)> &callback)
 {
-    QSqlQuery query(db);
-    query.prepare("UPDATE matches SET result = ?, locked = 0 WHERE id = ?");
+    OT_TRACE_SCOPE("Database::forEachMatch");
+
+    // Every tournament file in turn in the split layout
+    if (tournamentId == -1 && splitLayout)
+    {
+        int visited = 0;
+        bool keepGoing = true;
+        for (int id : getTournamentFileIds())
+        {
+            int count = forEachMatch(id, [&callback, &keepGoing](const MatchRecord &record)
+                                     { return keepGoing = callback(record); });
+            if (count == -1)
+            {
+                return -1;
+            }
+
+            visited += count;
+            if (!keepGoing)
+            {
+                break;
+            }
+        }
+        return visited;
+    }
+
+    if (!attachTournament(tournamentId))
+    {
+        return -1;
+    }
+
+    // The result is mapped to MatchRecord::Result in SQL so no string is decoded
+    const QString sql = QString("SELECT id, tournament_id, round, p1, p2, "
+                                "CASE result WHEN 'p1' THEN 1 WHEN 'p2' THEN 2 WHEN 'draw' THEN 3 ELSE 0 END, locked "
+                                "FROM matches %1ORDER BY round, id")
+                            .arg(tournamentId == -1 ? "" : "WHERE tournament_id = ? ");
+
+    MatchRecord record;
+    int visited = 0;
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    if (sqlite3 *handle = nativeHandle())
+    {
+        QElapsedTimer timer;
+        timer.start();
+        NativeStatement statement(nativeStatement(handle, sql));
+        if (statement.isValid())
+        {
+            if (tournamentId != -1)
+            {
+                statement.bind(1, tournamentId);
+            }
+
+            bool stopped = false;
+            while (!stopped && statement.step())
+            {
+                record.id = statement.intValue(0);
+                record.tournamentId = statement.intValue(1);
+                record.round = statement.intValue(2);
+                record.p1 = statement.intValue(3);
+                record.p2 = statement.intValue(4);
+                record.result = static_cast<MatchRecord::Result>(statement.intValue(5));
+                record.locked = statement.intValue(6) != 0;
+                ++visited;
+                stopped = !callback(record);
+            }
+            recordNativeStatement(sql, timer.nsecsElapsed(), visited);
+
+            // Rows already handed to the callback cannot be replayed through QtSql
+            return stopped || statement.isDone() ? visited : -1;
+        }
+    }
+#endif
+
+    QSqlQuery &query = cachedQuery(sql);
+    QueryReset reset(query);
+    if (tournamentId != -1)
+    {
+        query.addBindValue(tournamentId);
+    }
+
+    if (!exec(query))
+    {
+        qDebug() << "Failed to scan matches:" << query.lastError().text();
+        return -1;
+    }
+
+    while (next(query))
+    {
+        record.id = query.value(0).toInt();
+        record.tournamentId = query.value(1).toInt();
+        record.round = query.value(2).toInt();
+        record.p1 = query.value(3).toInt();
+        record.p2 = query.value(4).toInt();
+        record.result = static_cast<MatchRecord::Result>(query.value(5).toInt());
+        record.locked = query.value(6).toBool();
+        ++visited;
+
+        if (!callback(record))
+        {
+            break;
+        }
+    }
+
+    return visited;
+}
+
+Match Database::recordResult(int tournamentId, int matchId, const QString &result, bool lock)
+{
+    OT_TRACE_SCOPE("Database::recordResult");
+    if (!attachTournament(tournamentId))
+    {
+        return Match();
+    }
+
+    // Match ids restart in every tournament, so the key is (id, tournament_id).
+    // A locked result is final, as it is for commitResults().
+    QSqlQuery &query = cachedQuery("UPDATE matches SET result = ?, locked = ? "
+                                   "WHERE id = ? AND tournament_id = ? AND locked = 0 "
+                                   "RETURNING id, tournament_id, round, p1, p2, result, locked");
+    QueryReset reset(query);
     query.addBindValue(result);
+    query.addBindValue(lock ? 1 : 0);
     query.addBindValue(matchId);
+    query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
-        qDebug() << "Failed to update match result:" << query.lastError().text();
-        return false;
+        qDebug() << "Failed to record match result:" << query.lastError().text();
+        return Match();
     }
 
-    return query.numRowsAffected() > 0;
+    if (!next(query))
+    {
+        return Match();
+    }
+
+    return Match(query.value(0).toInt(), query.value(1).toInt(), query.value(2).toInt(), query.value(3).toInt(),
+                 query.value(4).toInt(), query.value(5).toString(), query.value(6).toBool());
 }
 
-bool Database::lockMatch(int matchId)
+bool Database::unlockMatch(int tournamentId, int matchId)
 {
-    QSqlQuery query(db);
-    query.prepare("UPDATE matches SET locked = 1 WHERE id = ? AND result IS NOT NULL");
+    OT_TRACE_SCOPE("Database::unlockMatch");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
+    QSqlQuery &query = cachedQuery("UPDATE matches SET locked = 0 WHERE id = ? AND tournament_id = ?");
+    QueryReset reset(query);
     query.addBindValue(matchId);
+    query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
-        qDebug() << "Failed to lock match:" << query.lastError().text();
+        qDebug() << "Failed to unlock match:" << query.lastError().text();
         return false;
     }
 
     return query.numRowsAffected() > 0;
 }
 
-bool Database::unlockMatch(int matchId)
+bool Database::deleteMatch(int tournamentId, int matchId)
 {
+    OT_TRACE_SCOPE("Database::deleteMatch");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
     QSqlQuery query(db);
-    query.prepare("UPDATE matches SET locked = 0 WHERE id = ?");
+    query.prepare("DELETE FROM matches WHERE id = ? AND tournament_id = ?");
     query.addBindValue(matchId);
+    query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
-        qDebug() << "Failed to unlock match:" << query.lastError().text();
+        qDebug() << "Failed to delete match:" << query.lastError().text();
         return false;
     }
 
     return query.numRowsAffected() > 0;
 }
 
-bool Database::deleteMatch(int id)
+int Database::commitResults(int tournamentId, const QMap<int, QString> &results, QList<int> *skipped)
 {
-    QSqlQuery query(db);
-    query.prepare("DELETE FROM matches WHERE id = ?");
-    query.addBindValue(id);
+    OT_TRACE_SCOPE("Database::commitResults");
+    if (!attachTournament(tournamentId))
+    {
+        return -1;
+    }
+
+    // Begin transaction so the whole batch is written with a single commit
+    if (!beginTransaction())
+    {
+        qDebug() << "Failed to begin result batch transaction:" << db.lastError().text();
+        return -1;
+    }
+
+    // Set and lock every result with one prepared statement. Staged results
+    // (possibly recovered from the journal) never overwrite a locked board.
+    QSqlQuery &query = cachedQuery("UPDATE matches SET result = ?, locked = 1 "
+                                   "WHERE id = ? AND tournament_id = ? AND locked = 0");
+    QueryReset reset(query);
+
+    QList<int> notUpdated;
+    int updatedCount = 0;
+    for (auto it = results.constBegin(); it != results.constEnd(); ++it)
+    {
+        query.bindValue(0, it.value());
+        query.bindValue(1, it.key());
+        query.bindValue(2, tournamentId);
+
+        if (!exec(query))
+        {
+            qDebug() << "Failed to commit match result:" << query.lastError().text();
+            rollbackTransaction();
+            return -1;
+        }
+
+        if (query.numRowsAffected() > 0)
+        {
+            updatedCount += query.numRowsAffected();
+        }
+        else
+        {
+            notUpdated.append(it.key());
+        }
+    }
+
+    // Commit transaction
+    if (!commitTransaction())
+    {
+        qDebug() << "Failed to commit result batch transaction:" << db.lastError().text();
+        return -1;
+    }
 
-    if (!query.exec())
+    if (skipped)
     {
-        qDebug() << "Failed to delete match:" << query.lastError().text();
-        return false;
+        *skipped = notUpdated;
     }
-
-    return query.numRowsAffected() > 0;
+    return updatedCount;
 }
 
 // Tournament operations
 int Database::addTournament(const QString &name)
 {
+    OT_TRACE_SCOPE("Database::addTournament");
     QSqlQuery query(db);
-    query.prepare("INSERT INTO tournaments (name, pairing_system, status) VALUES (?, ?, ?)");
+    query.prepare("INSERT INTO tournaments (name, pairing_system, status, created_at) VALUES (?, ?, ?, ?)");
     query.addBindValue(name);
     query.addBindValue("round_robin"); // default pairing system
     query.addBindValue("setup");       // default status
+    query.addBindValue(QDateTime::currentSecsSinceEpoch());
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to add tournament:" << query.lastError().text();
         return -1;
     }
 
-    return query.lastInsertId().toInt();
+    int tournamentId = query.lastInsertId().toInt();
+
+    // The file itself is created the first time the tournament is attached
+    if (splitLayout)
+    {
+        query.prepare("INSERT INTO tournament_files (tournament_id, file) VALUES (?, ?)");
+        query.addBindValue(tournamentId);
+        query.addBindValue(QString("tournament-%1.db").arg(tournamentId));
+
+        if (!QDir().mkpath(getTournamentDirectory()) || !exec(query))
+        {
+            qDebug() << "Failed to add tournament file:" << query.lastError().text();
+            return -1;
+        }
+    }
+
+    return tournamentId;
 }
 
 QList<Tournament> Database::getAllTournaments()
 {
+    OT_TRACE_SCOPE("Database::getAllTournaments");
     QList<Tournament> tournaments;
     QSqlQuery query(db);
-    query.prepare("SELECT id, name, pairing_system, status, created_at, started_at, completed_at FROM tournaments ORDER BY created_at DESC");
+    query.prepare("SELECT id, name, pairing_system, status, created_at, started_at, completed_at FROM tournaments ORDER BY created_at DESC, id DESC");
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to get tournaments:" << query.lastError().text();
         return tournaments;
     }
 
-    while (query.next())
+    while (next(query))
     {
         int id = query.value(0).toInt();
         QString name = query.value(1).toString();
         QString pairingSystem = query.value(2).toString();
         QString statusString = query.value(3).toString();
-        QDateTime createdAt = query.value(4).toDateTime();
-        QDateTime startedAt = query.value(5).toDateTime();
-        QDateTime completedAt = query.value(6).toDateTime();
+        QDateTime createdAt = dateTimeFromEpoch(query.value(4));
+        QDateTime startedAt = dateTimeFromEpoch(query.value(5));
+        QDateTime completedAt = dateTimeFromEpoch(query.value(6));
 
         Tournament tournament(id, name, createdAt);
         tournament.setPairingSystem(pairingSystem);
@@ -687,11 +2298,12 @@ QList<Tournament> Database::getAllTournaments()
 
 Tournament Database::getTournamentById(int id)
 {
-    QSqlQuery query(db);
-    query.prepare("SELECT id, name, pairing_system, status, created_at, started_at, completed_at FROM tournaments WHERE id = ?");
+    OT_TRACE_SCOPE("Database::getTournamentById");
+    QSqlQuery &query = cachedQuery("SELECT id, name, pairing_system, status, created_at, started_at, completed_at FROM tournaments WHERE id = ?");
+    QueryReset reset(query);
     query.addBindValue(id);
 
-    if (!query.exec() || !query.next())
+    if (!exec(query) || !next(query))
     {
         qDebug() << "Failed to get tournament by ID:" << query.lastError().text();
         return Tournament(); // Return default tournament
@@ -700,9 +2312,9 @@ Tournament Database::getTournamentById(int id)
     QString name = query.value(1).toString();
     QString pairingSystem = query.value(2).toString();
     QString statusString = query.value(3).toString();
-    QDateTime createdAt = query.value(4).toDateTime();
-    QDateTime startedAt = query.value(5).toDateTime();
-    QDateTime completedAt = query.value(6).toDateTime();
+    QDateTime createdAt = dateTimeFromEpoch(query.value(4));
+    QDateTime startedAt = dateTimeFromEpoch(query.value(5));
+    QDateTime completedAt = dateTimeFromEpoch(query.value(6));
 
     Tournament tournament(id, name, createdAt);
     tournament.setPairingSystem(pairingSystem);
@@ -713,19 +2325,87 @@ Tournament Database::getTournamentById(int id)
     return tournament;
 }
 
-bool Database::updateTournament(const Tournament &tournament)
+QList<TournamentCatalogEntry> Database::getTournamentCatalog(int limit, int offset, const QString &statusFilter)
+{
+    OT_TRACE_SCOPE("Database::getTournamentCatalog");
+    QList<TournamentCatalogEntry> catalog;
+    QSqlQuery query(db);
+
+    QString sql = "SELECT id, name, status FROM tournaments";
+    if (!statusFilter.isEmpty())
+    {
+        sql += " WHERE status = ?";
+    }
+    sql += " ORDER BY created_at DESC, id DESC LIMIT ? OFFSET ?";
+
+    query.prepare(sql);
+    if (!statusFilter.isEmpty())
+    {
+        query.addBindValue(statusFilter);
+    }
+    query.addBindValue(limit);
+    query.addBindValue(offset);
+    query.setForwardOnly(true);
+
+    if (!exec(query))
+    {
+        qDebug() << "Failed to get tournament catalog:" << query.lastError().text();
+        return catalog;
+    }
+
+    // Reuse Tournament's status mapping rather than duplicating it here
+    Tournament statusParser;
+    while (next(query))
+    {
+        statusParser.setStatusFromString(query.value(2).toString());
+
+        TournamentCatalogEntry entry;
+        entry.id = query.value(0).toInt();
+        entry.name = query.value(1).toString();
+        entry.status = statusParser.getStatus();
+        catalog.append(entry);
+    }
+
+    return catalog;
+}
+
+int Database::getTournamentCount(const QString &statusFilter)
 {
+    OT_TRACE_SCOPE("Database::getTournamentCount");
     QSqlQuery query(db);
-    query.prepare("UPDATE tournaments SET name = ?, pairing_system = ?, status = ?, created_at = ?, started_at = ?, completed_at = ? WHERE id = ?");
+    if (statusFilter.isEmpty())
+    {
+        query.prepare("SELECT COUNT(*) FROM tournaments");
+    }
+    else
+    {
+        query.prepare("SELECT COUNT(*) FROM tournaments WHERE status = ?");
+        query.addBindValue(statusFilter);
+    }
+
+    if (!exec(query) || !next(query))
+    {
+        qDebug() << "Failed to count tournaments:" << query.lastError().text();
+        return -1;
+    }
+
+    return query.value(0).toInt();
+}
+
+bool Database::updateTournament(const Tournament &tournament)
+{
+    OT_TRACE_SCOPE("Database::updateTournament");
+    QSqlQuery &query = cachedQuery("UPDATE tournaments SET name = ?, pairing_system = ?, status = ?, created_at = ?, started_at = ?, completed_at = ? WHERE id = ?");
+    QueryReset reset(query);
     query.addBindValue(tournament.getName());
     query.addBindValue(tournament.getPairingSystem());
     query.addBindValue(tournament.getStatusString());
-    query.addBindValue(tournament.getCreatedAt());
-    query.addBindValue(tournament.getStartedAt());
-    query.addBindValue(tournament.getCompletedAt());
+    query.addBindValue(epochFromDateTime(tournament.getCreatedAt()));
+    query.addBindValue(epochFromDateTime(tournament.getStartedAt()));
+    query.addBindValue(epochFromDateTime(tournament.getCompletedAt()));
     query.addBindValue(tournament.getId());
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to update tournament:" << query.lastError().text();
         return false;
@@ -736,12 +2416,13 @@ bool Database::updateTournament(const Tournament &tournament)
 
 bool Database::startTournament(int id)
 {
+    OT_TRACE_SCOPE("Database::startTournament");
     QSqlQuery query(db);
-    query.prepare("UPDATE tournaments SET status = ?, started_at = datetime('now') WHERE id = ?");
+    query.prepare("UPDATE tournaments SET status = ?, started_at = strftime('%s', 'now') WHERE id = ?");
     query.addBindValue("active");
     query.addBindValue(id);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to start tournament:" << query.lastError().text();
         return false;
@@ -752,12 +2433,13 @@ bool Database::startTournament(int id)
 
 bool Database::completeTournament(int id)
 {
+    OT_TRACE_SCOPE("Database::completeTournament");
     QSqlQuery query(db);
-    query.prepare("UPDATE tournaments SET status = ?, completed_at = datetime('now') WHERE id = ?");
+    query.prepare("UPDATE tournaments SET status = ?, completed_at = strftime('%s', 'now') WHERE id = ?");
     query.addBindValue("completed");
     query.addBindValue(id);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to complete tournament:" << query.lastError().text();
         return false;
@@ -768,19 +2450,25 @@ bool Database::completeTournament(int id)
 
 bool Database::deleteTournament(int id)
 {
+    OT_TRACE_SCOPE("Database::deleteTournament");
+    if (splitLayout)
+    {
+        return removeTournamentFile(id);
+    }
+
     QSqlQuery query(db);
 
     // Begin transaction for atomicity
-    db.transaction();
+    beginTransaction();
 
     // Delete matches for this tournament
     query.prepare("DELETE FROM matches WHERE tournament_id = ?");
     query.addBindValue(id);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete matches for tournament:" << query.lastError().text();
-        db.rollback();
+        rollbackTransaction();
         return false;
     }
 
@@ -788,10 +2476,10 @@ bool Database::deleteTournament(int id)
     query.prepare("DELETE FROM tournament_results WHERE tournament_id = ?");
     query.addBindValue(id);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete tournament results:" << query.lastError().text();
-        db.rollback();
+        rollbackTransaction();
         return false;
     }
 
@@ -799,10 +2487,10 @@ bool Database::deleteTournament(int id)
     query.prepare("DELETE FROM player_tournaments WHERE tournament_id = ?");
     query.addBindValue(id);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete player tournament associations:" << query.lastError().text();
-        db.rollback();
+        rollbackTransaction();
         return false;
     }
 
@@ -810,10 +2498,10 @@ bool Database::deleteTournament(int id)
     query.prepare("DELETE FROM match_id_sequence WHERE tournament_id = ?");
     query.addBindValue(id);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete match ID sequence entries:" << query.lastError().text();
-        db.rollback();
+        rollbackTransaction();
         return false;
     }
 
@@ -821,15 +2509,15 @@ bool Database::deleteTournament(int id)
     query.prepare("DELETE FROM tournaments WHERE id = ?");
     query.addBindValue(id);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete tournament:" << query.lastError().text();
-        db.rollback();
+        rollbackTransaction();
         return false;
     }
 
     // Commit transaction
-    if (!db.commit())
+    if (!commitTransaction())
     {
         qDebug() << "Failed to commit tournament deletion transaction:" << db.lastError().text();
         return false;
@@ -841,18 +2529,24 @@ bool Database::deleteTournament(int id)
 // Utility methods
 bool Database::removeTournament(int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::removeTournament");
+    if (splitLayout && !removeTournamentFile(tournamentId))
+    {
+        return false;
+    }
+
     QSqlQuery query(db);
 
     // Delete the tournament itself
     query.prepare("DELETE FROM tournaments WHERE id = :tournamentId");
     query.bindValue(":tournamentId", tournamentId);
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete tournament:" << query.lastError().text();
         return false;
     }
 
-    if (!query.exec("DELETE FROM sqlite_sequence WHERE name = 'tournaments'"))
+    if (!exec(query, "DELETE FROM sqlite_sequence WHERE name = 'tournaments'"))
     {
         qDebug() << "Failed to reset tournaments sequence:" << query.lastError().text();
         return false;
@@ -863,19 +2557,25 @@ bool Database::removeTournament(int tournamentId)
 
 bool Database::resetDatabase(int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::resetDatabase");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
     QSqlQuery query(db);
 
     // Delete all matches for this tournament
     query.prepare("DELETE FROM matches WHERE tournament_id = :tournamentId");
     query.bindValue(":tournamentId", tournamentId);
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete matches:" << query.lastError().text();
         return false;
     }
 
     // Reset autoincrement counters
-    if (!query.exec("DELETE FROM sqlite_sequence WHERE name = 'matches'"))
+    if (!exec(query, "DELETE FROM sqlite_sequence WHERE name = 'matches'"))
     {
         qDebug() << "Failed to reset matches sequence:" << query.lastError().text();
         return false;
@@ -886,18 +2586,24 @@ bool Database::resetDatabase(int tournamentId)
 
 QList<Match> Database::getMatchesForTournament(int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::getMatchesForTournament");
+    if (!attachTournament(tournamentId))
+    {
+        return QList<Match>();
+    }
+
     QList<Match> matches;
-    QSqlQuery query(db);
-    query.prepare("SELECT id, tournament_id, round, p1, p2, result, locked FROM matches WHERE tournament_id = ? ORDER BY round, id");
+    QSqlQuery &query = cachedQuery("SELECT id, tournament_id, round, p1, p2, result, locked FROM matches WHERE tournament_id = ? ORDER BY round, id");
+    QueryReset reset(query);
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to get matches for tournament:" << query.lastError().text();
         return matches;
     }
 
-    while (query.next())
+    while (next(query))
     {
         int id = query.value(0).toInt();
         int tournamentId = query.value(1).toInt();
@@ -914,11 +2620,17 @@ QList<Match> Database::getMatchesForTournament(int tournamentId)
 
 bool Database::deleteMatchesForTournament(int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::deleteMatchesForTournament");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
     QSqlQuery query(db);
     query.prepare("DELETE FROM matches WHERE tournament_id = ?");
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete matches for tournament:" << query.lastError().text();
         return false;
@@ -929,11 +2641,17 @@ bool Database::deleteMatchesForTournament(int tournamentId)
 
 bool Database::resetMatchIdSequence(int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::resetMatchIdSequence");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
     QSqlQuery query(db);
     query.prepare("DELETE FROM match_id_sequence WHERE tournament_id = ?");
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to reset match ID sequence for tournament:" << query.lastError().text();
         return false;
@@ -944,53 +2662,57 @@ bool Database::resetMatchIdSequence(int tournamentId)
 
 bool Database::saveTournamentResults(int tournamentId, const QList<TournamentResult> &results)
 {
+    OT_TRACE_SCOPE("Database::saveTournamentResults");
+    if (!attachTournament(tournamentId))
+    {
+        return false;
+    }
+
     QSqlQuery query(db);
 
     // Begin transaction for atomicity
-    db.transaction();
+    beginTransaction();
 
     // Delete any existing results for this tournament
     query.prepare("DELETE FROM tournament_results WHERE tournament_id = ?");
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to delete existing tournament results:" << query.lastError().text();
-        db.rollback();
+        rollbackTransaction();
         return false;
     }
 
-    // Insert new results
-    query.prepare("INSERT INTO tournament_results (tournament_id, player_id, player_name, final_rank, points, wins, losses, draws, buchholz_cut_one, sonneborn_berger, number_of_wins, cumulative_opponent_score) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    // Insert new results, reusing one prepared statement for every row
+    QSqlQuery &insertQuery = cachedQuery("INSERT INTO tournament_results (tournament_id, player_id, player_name, final_rank, points, wins, losses, draws, buchholz_cut_one, sonneborn_berger, number_of_wins, cumulative_opponent_score) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    QueryReset insertReset(insertQuery);
 
     for (const TournamentResult &result : results)
     {
-        query.addBindValue(tournamentId);
-        query.addBindValue(result.playerId);
-        query.addBindValue(result.playerName);
-        query.addBindValue(result.finalRank);
-        query.addBindValue(result.points);
-        query.addBindValue(result.wins);
-        query.addBindValue(result.losses);
-        query.addBindValue(result.draws);
-        query.addBindValue(result.buchholzCutOne);
-        query.addBindValue(result.sonnebornBerger);
-        query.addBindValue(result.numberOfWins);
-        query.addBindValue(result.cumulativeOpponentScore);
-
-        if (!query.exec())
+        insertQuery.addBindValue(tournamentId);
+        insertQuery.addBindValue(result.playerId);
+        insertQuery.addBindValue(result.playerName);
+        insertQuery.addBindValue(result.finalRank);
+        insertQuery.addBindValue(result.points);
+        insertQuery.addBindValue(result.wins);
+        insertQuery.addBindValue(result.losses);
+        insertQuery.addBindValue(result.draws);
+        insertQuery.addBindValue(result.buchholzCutOne);
+        insertQuery.addBindValue(result.sonnebornBerger);
+        insertQuery.addBindValue(result.numberOfWins);
+        insertQuery.addBindValue(result.cumulativeOpponentScore);
+
+        if (!exec(insertQuery))
         {
-            qDebug() << "Failed to insert tournament result:" << query.lastError().text();
-            db.rollback();
+            qDebug() << "Failed to insert tournament result:" << insertQuery.lastError().text();
+            rollbackTransaction();
             return false;
         }
-
-        // Prepare for next iteration
-        query.prepare("INSERT INTO tournament_results (tournament_id, player_id, player_name, final_rank, points, wins, losses, draws, buchholz_cut_one, sonneborn_berger, number_of_wins, cumulative_opponent_score) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
     }
 
     // Commit transaction
-    if (!db.commit())
+    if (!commitTransaction())
     {
         qDebug() << "Failed to commit tournament results transaction:" << db.lastError().text();
         return false;
@@ -1001,18 +2723,59 @@ bool Database::saveTournamentResults(int tournamentId, const QList<TournamentRes
 
 QList<TournamentResult> Database::getTournamentResults(int tournamentId)
 {
+    OT_TRACE_SCOPE("Database::getTournamentResults");
+    if (!attachTournament(tournamentId))
+    {
+        return QList<TournamentResult>();
+    }
+
     QList<TournamentResult> results;
-    QSqlQuery query(db);
-    query.prepare("SELECT player_id, player_name, final_rank, points, wins, losses, draws, buchholz_cut_one, sonneborn_berger, number_of_wins, cumulative_opponent_score FROM tournament_results WHERE tournament_id = ? ORDER BY final_rank");
+    const QString sql = "SELECT player_id, player_name, final_rank, points, wins, losses, draws, buchholz_cut_one, sonneborn_berger, number_of_wins, cumulative_opponent_score FROM tournament_results WHERE tournament_id = ? ORDER BY final_rank";
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    if (sqlite3 *handle = nativeHandle())
+    {
+        QElapsedTimer timer;
+        timer.start();
+        NativeStatement statement(nativeStatement(handle, sql));
+        statement.bind(1, tournamentId);
+        while (statement.step())
+        {
+            TournamentResult result;
+            result.playerId = statement.intValue(0);
+            result.playerName = statement.textValue(1);
+            result.finalRank = statement.intValue(2);
+            result.points = statement.doubleValue(3);
+            result.wins = statement.intValue(4);
+            result.losses = statement.intValue(5);
+            result.draws = statement.intValue(6);
+            result.buchholzCutOne = statement.doubleValue(7);
+            result.sonnebornBerger = statement.doubleValue(8);
+            result.numberOfWins = statement.intValue(9);
+            result.cumulativeOpponentScore = statement.doubleValue(10);
+            results.append(result);
+        }
+        recordNativeStatement(sql, timer.nsecsElapsed(), results.size());
+
+        if (statement.isDone())
+        {
+            return results;
+        }
+        results.clear(); // Retry through QtSql
+    }
+#endif
+
+    QSqlQuery &query = cachedQuery(sql);
+    QueryReset reset(query);
     query.addBindValue(tournamentId);
 
-    if (!query.exec())
+    if (!exec(query))
     {
         qDebug() << "Failed to get tournament results:" << query.lastError().text();
         return results;
     }
 
-    while (query.next())
+    while (next(query))
     {
         TournamentResult result;
         result.playerId = query.value(0).toInt();
@@ -1031,4 +2794,474 @@ QList<TournamentResult> Database::getTournamentResults(int tournamentId)
     }
 
     return results;
-}
\ No newline at end of file
+}
+
+QList<PlayerStanding> Database::getStandings(int tournamentId)
+{
+    OT_TRACE_SCOPE("Database::getStandings");
+    if (!attachTournament(tournamentId))
+    {
+        return QList<PlayerStanding>();
+    }
+
+    QList<PlayerStanding> standings;
+    const QString sql = "SELECT s.player_id, p.name, s.half_points, s.wins, s.losses, s.draws "
+                        "FROM player_standings s JOIN players p ON p.id = s.player_id "
+                        "WHERE s.tournament_id = ? ORDER BY s.half_points DESC, p.name";
+
+    // Tiebreakers are left at zero, as Standings::compute() leaves them
+    // when it is not asked for them
+    auto makeStanding = [](int playerId, const QString &name, int halfPoints, int wins, int losses, int draws)
+    {
+        PlayerStanding standing;
+        standing.playerId = playerId;
+        standing.playerName = name;
+        standing.points = halfPoints / 2.0;
+        standing.wins = wins;
+        standing.losses = losses;
+        standing.draws = draws;
+        standing.buchholzCutOne = 0.0;
+        standing.sonnebornBerger = 0.0;
+        standing.numberOfWins = 0;
+        standing.cumulativeOpponentScore = 0.0;
+        return standing;
+    };
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    if (sqlite3 *handle = nativeHandle())
+    {
+        QElapsedTimer timer;
+        timer.start();
+        NativeStatement statement(nativeStatement(handle, sql));
+        statement.bind(1, tournamentId);
+        while (statement.step())
+        {
+            standings.append(makeStanding(statement.intValue(0), statement.textValue(1), statement.intValue(2),
+                                          statement.intValue(3), statement.intValue(4), statement.intValue(5)));
+        }
+        recordNativeStatement(sql, timer.nsecsElapsed(), standings.size());
+
+        if (statement.isDone())
+        {
+            return standings;
+        }
+        standings.clear(); // Retry through QtSql
+    }
+#endif
+
+    QSqlQuery &query = cachedQuery(sql);
+    QueryReset reset(query);
+    query.addBindValue(tournamentId);
+
+    if (!exec(query))
+    {
+        qDebug() << "Failed to get standings:" << query.lastError().text();
+        return standings;
+    }
+
+    while (next(query))
+    {
+        standings.append(makeStanding(query.value(0).toInt(), query.value(1).toString(), query.value(2).toInt(),
+                                      query.value(3).toInt(), query.value(4).toInt(), query.value(5).toInt()));
+    }
+
+    return standings;
+}
+
+StartupSnapshot Database::loadStartupSnapshot(const QString &databasePath)
+{
+    OT_TRACE_SCOPE("Database::loadStartupSnapshot");
+    StartupSnapshot snapshot;
+    QElapsedTimer timer;
+    timer.start();
+
+    {
+        // Connections can only be used from the thread that created them
+        Database database(databasePath, "startup");
+        snapshot.schemaReady = database.connect();
+        snapshot.schemaMs = timer.restart();
+
+        if (snapshot.schemaReady)
+        {
+            snapshot.tournaments = database.getTournamentCatalog();
+            if (!snapshot.tournaments.isEmpty())
+            {
+                snapshot.tournamentId = snapshot.tournaments.first().id;
+                snapshot.tournament = database.getTournamentById(snapshot.tournamentId);
+                snapshot.players = database.getPlayersForTournament(snapshot.tournamentId);
+                snapshot.matches = database.getAllMatches(snapshot.tournamentId);
+            }
+            snapshot.loadMs = timer.elapsed();
+        }
+    }
+
+    return snapshot;
+}
+
+bool Database::copyTo(Database &destination, int pagesPerStep, int stepPauseMs)
+{
+    OT_TRACE_SCOPE("Database::copyTo");
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    sqlite3 *source = sqliteHandle();
+    sqlite3 *target = destination.sqliteHandle();
+    if (source && target)
+    {
+        sqlite3_backup *backup = sqlite3_backup_init(target, "main", source, "main");
+        if (!backup)
+        {
+            qDebug() << "Failed to start backup:" << sqlite3_errmsg(target);
+            return false;
+        }
+
+        int rc;
+        do
+        {
+            rc = sqlite3_backup_step(backup, pagesPerStep);
+
+            // Let writers in between steps, and back off while either side is locked
+            if (rc == SQLITE_BUSY || rc == SQLITE_LOCKED || (rc == SQLITE_OK && stepPauseMs > 0))
+            {
+                QThread::msleep(qMax(stepPauseMs, 1));
+            }
+        } while (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED);
+
+        sqlite3_backup_finish(backup);
+        if (rc != SQLITE_DONE)
+        {
+            qDebug() << "Backup failed:" << sqlite3_errstr(rc);
+            return false;
+        }
+
+        return true;
+    }
+#else
+    Q_UNUSED(pagesPerStep);
+    Q_UNUSED(stepPauseMs);
+#endif
+
+    // Without the SQLite API the copy is made in one transaction instead
+    return destination.replaceWithCopyOf(dbPath);
+}
+
+bool Database::replaceWithCopyOf(const QString &sourcePath)
+{
+    OT_TRACE_SCOPE("Database::replaceWithCopyOf");
+    QSqlQuery query(db);
+
+    // ATTACH cannot run inside a transaction
+    query.prepare("ATTACH DATABASE ? AS source");
+    query.addBindValue(sourcePath);
+    if (!exec(query))
+    {
+        qDebug() << "Error attaching" << sourcePath << ":" << query.lastError().text();
+        return false;
+    }
+
+    QStringList existingTables;
+    QStringList tables;
+    QStringList tableSql;
+    QStringList otherSql; // Indexes, triggers and views, created once the rows are in
+    QStringList virtualTables; // Full-text indexes, rebuilt from their content once the rows are in
+    bool hasSequence = false;
+    int userVersion = 0;
+
+    // Shadow tables come and go with their virtual table, and follow it in
+    // sqlite_master
+    auto isShadowTable = [](const QString &name, const QStringList &virtualTables)
+    {
+        for (const QString &virtualTable : virtualTables)
+        {
+            if (name.startsWith(virtualTable + "_"))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (exec(query, "SELECT name, sql FROM main.sqlite_master WHERE type = 'table' AND name NOT LIKE 'sqlite_%' ORDER BY rowid"))
+    {
+        QStringList existingVirtualTables;
+        while (next(query))
+        {
+            QString name = query.value(0).toString();
+            if (query.value(1).toString().startsWith("CREATE VIRTUAL TABLE", Qt::CaseInsensitive))
+            {
+                existingVirtualTables.append(name);
+            }
+            else if (isShadowTable(name, existingVirtualTables))
+            {
+                continue;
+            }
+            existingTables.append(name);
+        }
+    }
+
+    if (exec(query, "SELECT type, name, sql FROM source.sqlite_master ORDER BY rowid"))
+    {
+        while (next(query))
+        {
+            QString type = query.value(0).toString();
+            QString name = query.value(1).toString();
+            if (name == "sqlite_sequence")
+            {
+                hasSequence = true;
+            }
+            else if (name.startsWith("sqlite_") || query.value(2).isNull() ||
+                     (type == "table" && isShadowTable(name, virtualTables)))
+            {
+                continue;
+            }
+            else if (type == "table" && query.value(2).toString().startsWith("CREATE VIRTUAL TABLE", Qt::CaseInsensitive))
+            {
+                virtualTables.append(name);
+                otherSql.append(query.value(2).toString());
+            }
+            else if (type == "table")
+            {
+                tables.append(name);
+                tableSql.append(query.value(2).toString());
+            }
+            else
+            {
+                otherSql.append(query.value(2).toString());
+            }
+        }
+    }
+
+    if (exec(query, "PRAGMA source.user_version") && next(query))
+    {
+        userVersion = query.value(0).toInt();
+    }
+
+    beginTransaction();
+    bool ok = true;
+
+    for (const QString &table : existingTables)
+    {
+        ok = ok && exec(query, QString("DROP TABLE main.\"%1\"").arg(table));
+    }
+
+    for (int i = 0; i < tables.size(); ++i)
+    {
+        ok = ok && exec(query, tableSql[i]) &&
+             exec(query, QString("INSERT INTO main.\"%1\" SELECT * FROM source.\"%1\"").arg(tables[i]));
+    }
+
+    if (ok && hasSequence)
+    {
+        ok = exec(query, "DELETE FROM main.sqlite_sequence") &&
+             exec(query, "INSERT INTO main.sqlite_sequence SELECT * FROM source.sqlite_sequence");
+    }
+
+    for (const QString &sql : otherSql)
+    {
+        ok = ok && exec(query, sql);
+    }
+
+    for (const QString &table : virtualTables)
+    {
+        ok = ok && exec(query, QString("INSERT INTO main.\"%1\" (\"%1\") VALUES ('rebuild')").arg(table));
+    }
+
+    ok = ok && exec(query, QString("PRAGMA main.user_version = %1").arg(userVersion));
+
+    if (ok)
+    {
+        ok = commitTransaction();
+    }
+    else
+    {
+        qDebug() << "Error copying" << sourcePath << ":" << query.lastError().text();
+        rollbackTransaction();
+    }
+
+    exec(query, "DETACH DATABASE source");
+    return ok;
+}
+
+bool Database::quickCheck()
+{
+    OT_TRACE_SCOPE("Database::quickCheck");
+    QSqlQuery query(db);
+    if (!exec(query, "PRAGMA quick_check") || !next(query))
+    {
+        qDebug() << "Error checking database:" << query.lastError().text();
+        return false;
+    }
+
+    // A healthy database returns a single row reading "ok"
+    QString result = query.value(0).toString();
+    if (result != "ok")
+    {
+        qDebug() << "Database check failed:" << result;
+        return false;
+    }
+
+    return true;
+}
+
+MaintenanceReport Database::runMaintenance(int budgetMs, const std::function<bool()> &isCanceled)
+{
+    OT_TRACE_SCOPE("Database::runMaintenance");
+    MaintenanceReport report;
+    if (transactionDepth > 0)
+    {
+        qDebug() << "Cannot run maintenance inside a transaction";
+        return report;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QDeadlineTimer deadline(qMax(0, budgetMs));
+    const qint64 startedAt = QDateTime::currentSecsSinceEpoch();
+    auto stopped = [&]()
+    { return deadline.hasExpired() || (isCanceled && isCanceled()); };
+
+    report.pageSize = pragmaValue("page_size");
+    report.pagesBefore = pragmaValue("page_count");
+    int freePages = pragmaValue("freelist_count");
+    if (report.pageSize <= 0 || report.pagesBefore < 0 || freePages < 0)
+    {
+        return report;
+    }
+    report.ok = true;
+
+    // Statistics. ANALYZE samples a bounded number of rows per index, so it
+    // stays cheap on large files. PRAGMA optimize only refreshes statistics
+    // that already exist, so they are gathered outright when missing or old.
+    QSqlQuery query(db);
+    exec(query, QString("PRAGMA analysis_limit = %1").arg(AnalysisRowLimit));
+
+    qint64 lastAnalyzed = 0;
+    if (exec(query, "SELECT MAX(started_at) FROM maintenance_log WHERE instr(steps, 'analyze') > 0") && next(query))
+    {
+        lastAnalyzed = query.value(0).toLongLong();
+    }
+    bool haveStatistics = exec(query, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'sqlite_stat1'") &&
+                          next(query);
+    query.finish();
+
+    if (!haveStatistics || lastAnalyzed < startedAt - qint64(AnalyzeIntervalDays) * 24 * 60 * 60)
+    {
+        report.ok = exec(query, "ANALYZE main");
+        report.steps << "analyze";
+    }
+    else
+    {
+        report.ok = exec(query, "PRAGMA optimize");
+        report.steps << "optimize";
+    }
+    query.finish();
+
+    if (!report.ok)
+    {
+        qDebug() << "Failed to update query planner statistics:" << query.lastError().text();
+    }
+
+    // Free pages. In-memory databases have no file to shrink.
+    bool pagesLeft = false;
+    if (report.ok && freePages > 0 && !isInMemory())
+    {
+        const int autoVacuum = pragmaValue("auto_vacuum");
+        if (autoVacuum == 2)
+        {
+            // Each execution frees one page; commit in chunks so other
+            // connections are never locked out for long
+            QSqlQuery vacuum(db);
+            vacuum.prepare("PRAGMA incremental_vacuum(1)");
+            while (freePages > 0 && !stopped())
+            {
+                beginTransaction();
+                bool ok = true;
+                for (int i = 0; ok && i < qMin(freePages, VacuumPagesPerChunk); ++i)
+                {
+                    ok = exec(vacuum);
+                }
+
+                if (!ok)
+                {
+                    qDebug() << "Failed to free pages:" << vacuum.lastError().text();
+                    rollbackTransaction();
+                    report.ok = false;
+                    break;
+                }
+                if (!commitTransaction())
+                {
+                    qDebug() << "Failed to commit freed pages:" << db.lastError().text();
+                    report.ok = false;
+                    break;
+                }
+
+                if (!report.steps.contains("incremental_vacuum"))
+                {
+                    report.steps << "incremental_vacuum";
+                }
+                freePages = pragmaValue("freelist_count");
+            }
+            pagesLeft = freePages > 0;
+        }
+        else if (autoVacuum == 0)
+        {
+            // Files made before incremental vacuum was enabled are switched
+            // over (open() asked for it) by one full VACUUM, once a quarter of
+            // the file is free and the rewrite fits in what is left of the budget
+            const qint64 fileBytes = qint64(report.pagesBefore) * report.pageSize;
+            if (qint64(freePages) * 4 >= report.pagesBefore && !stopped() &&
+                fileBytes <= deadline.remainingTime() * VacuumBytesPerMs)
+            {
+                report.ok = exec(query, "VACUUM");
+                report.steps << "vacuum";
+                if (!report.ok)
+                {
+                    qDebug() << "Failed to vacuum database:" << query.lastError().text();
+                }
+            }
+        }
+    }
+
+    report.pagesAfter = pragmaValue("page_count");
+    report.freePagesAfter = pragmaValue("freelist_count");
+    report.durationMs = timer.elapsed();
+    report.finished = report.ok && !pagesLeft;
+
+    query.prepare("INSERT INTO maintenance_log (started_at, duration_ms, steps, page_size, pages_before, pages_after, "
+                  "free_pages_after, finished) VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+    query.addBindValue(startedAt);
+    query.addBindValue(report.durationMs);
+    query.addBindValue(report.steps.join(','));
+    query.addBindValue(report.pageSize);
+    query.addBindValue(report.pagesBefore);
+    query.addBindValue(report.pagesAfter);
+    query.addBindValue(report.freePagesAfter);
+    query.addBindValue(report.finished ? 1 : 0);
+
+    // Only the newest runs are kept
+    if (!exec(query) ||
+        !exec(query, QString("DELETE FROM maintenance_log WHERE id <= (SELECT MAX(id) FROM maintenance_log) - %1")
+                         .arg(MaintenanceLogSize)))
+    {
+        qDebug() << "Failed to log maintenance:" << query.lastError().text();
+    }
+
+    return report;
+}
+
+int Database::getDataVersion()
+{
+    OT_TRACE_SCOPE("Database::getDataVersion");
+    return pragmaValue("data_version");
+}
+
+int Database::pragmaValue(const QString &pragma)
+{
+    OT_TRACE_SCOPE("Database::pragmaValue");
+    QSqlQuery query(db);
+    if (!exec(query, "PRAGMA " + pragma) || !next(query))
+    {
+        qDebug() << "Failed to read PRAGMA" << pragma << ":" << query.lastError().text();
+        return -1;
+    }
+
+    return query.value(0).toInt();
+}
@@ -4,9 +4,23 @@
 #include <QSqlDatabase>
 #include <QList>
 #include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QHash>
+#include <QSqlQuery>
+#include <QElapsedTimer>
+#include <functional>
+#include <memory>
 #include "Player.h"
 #include "Match.h"
 #include "Tournament.h"
+#include "Standings.h"
+#include "QueryStats.h"
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+struct sqlite3;
+struct sqlite3_stmt;
+#endif
 
 // Structure to hold tournament results data
 struct TournamentResult
@@ -24,22 +38,100 @@ struct TournamentResult
     double cumulativeOpponentScore;
 };
 
+// One player read from a roster file
+struct RosterEntry
+{
+    QString name;
+    int seed = 0;
+};
+
+// Outcome of importing a roster into a tournament
+struct RosterImportResult
+{
+    bool ok = false;
+    int added = 0;                 // New players created
+    int returning = 0;             // Existing players entered into the tournament
+    QStringList duplicates;        // Names listed more than once; later lines are skipped
+    QStringList alreadyRegistered; // Names already entered into the tournament
+};
+
+// What one maintenance run did; runs that did anything are kept in maintenance_log
+struct MaintenanceReport
+{
+    bool ok = false;
+    bool finished = false; // False when the budget ran out or the run was canceled with work left
+    QStringList steps;     // "analyze", "optimize", "vacuum" and/or "incremental_vacuum"
+    int pageSize = 0;
+    int pagesBefore = 0;
+    int pagesAfter = 0;
+    int freePagesAfter = 0; // Free pages still left in the file
+    qint64 durationMs = 0;
+};
+
+// Structure to hold the few tournament columns needed to list tournaments
+struct TournamentCatalogEntry
+{
+    int id;
+    QString name;
+    Tournament::Status status;
+};
+
+// Structure to hold everything the main window needs to show its first
+// tournament, loaded on a worker thread during startup
+struct StartupSnapshot
+{
+    bool schemaReady = false;
+    QList<TournamentCatalogEntry> tournaments;
+    Tournament tournament; // The first tournament in the catalog
+    int tournamentId = -1;
+    QList<Player> players;
+    QList<Match> matches;
+    qint64 schemaMs = 0; // Time spent opening the database and checking the schema
+    qint64 loadMs = 0;   // Time spent loading the first tournament
+};
+
 class Database
 {
 public:
-    // Constructor and destructor
-    Database();
+    // How the connection may use the database file
+    enum AccessMode
+    {
+        ReadWrite,
+        ReadOnly, // Opened with SQLITE_OPEN_READONLY; use open(), not connect()
+        Unconfigured // Read-write, but open() leaves the journal mode and auto_vacuum alone;
+                     // for backup copies, which the backup API refuses to write in WAL mode
+    };
+
+    // Constructor and destructor. An empty path uses tournament.db next to the
+    // executable; an empty connection name uses the default connection.
+    explicit Database(const QString &databasePath = QString(), const QString &connectionName = QString(),
+                      AccessMode accessMode = ReadWrite);
     ~Database();
 
     // Connection management
-    bool connect();
+    bool connect(); // Open and initialize the schema
+    bool open();    // Open without touching the schema; enables WAL (read-write mode only) and a busy timeout
     void disconnect();
     bool isConnected() const;
 
+    // Transactions. Calls may nest: inner calls join the outermost transaction,
+    // which is committed by the last commit or rolled back by any rollback.
+    bool beginTransaction();
+    bool commitTransaction();
+    bool rollbackTransaction();
+
     // Player operations
     int addPlayer(const QString &name, int seed = 0);
     int addPlayerToTournament(const QString &name, int tournamentId, int seed = 0);
+    // Enter every player produced by nextEntry (which returns false once the
+    // roster is exhausted) in one transaction. Names are resolved against
+    // the registry set-wise; a new player keeps the seed from the roster.
+    RosterImportResult importRoster(int tournamentId, const std::function<bool(RosterEntry &)> &nextEntry);
     QList<Player> getAllPlayers();
+    // Players in the registry whose names resemble the text, best match
+    // first: names containing it, then names sharing most of its letter
+    // triples, so misspelt names are still found
+    QList<Player> searchPlayers(const QString &text, int limit = 10);
     Player getPlayerById(int id);
     bool updatePlayer(const Player &player);
     bool deletePlayer(int id);
@@ -55,10 +147,20 @@ public:
     int addMatch(int tournamentId, int round, int p1, int p2);
     QList<Match> getMatchesForRound(int tournamentId, int round);
     QList<Match> getAllMatches(int tournamentId = -1); // -1 for all matches
-    bool updateMatchResult(int matchId, const QString &result);
-    bool lockMatch(int matchId);
-    bool unlockMatch(int matchId);
-    bool deleteMatch(int id);
+    // Visit matches in round order without building a list (-1 for all matches).
+    // The callback returns false to stop early. Returns the number of rows
+    // visited, -1 on failure.
+    int forEachMatch(int tournamentId, const std::function<bool(const MatchRecord &)> &callback);
+    // Set a match's result (and lock it) with one UPDATE; returns the updated
+    // match, or a default Match with id 0 if the tournament has no such match
+    // or it is locked (unlock it first to change a recorded result)
+    Match recordResult(int tournamentId, int matchId, const QString &result, bool lock = true);
+    bool unlockMatch(int tournamentId, int matchId);
+    bool deleteMatch(int tournamentId, int matchId);
+    // Set and lock a batch of results in one transaction. Matches locked since
+    // they were staged are left alone and, like missing ones, listed in
+    // skipped. Returns number of matches updated, -1 on failure.
+    int commitResults(int tournamentId, const QMap<int, QString> &results, QList<int> *skipped = nullptr);
 
     // Tournament match operations
     QList<Match> getMatchesForTournament(int tournamentId);
@@ -69,6 +171,9 @@ public:
     int addTournament(const QString &name);
     QList<Tournament> getAllTournaments();
     Tournament getTournamentById(int id);
+    // Newest first; a negative limit returns every row, an empty filter every status
+    QList<TournamentCatalogEntry> getTournamentCatalog(int limit = -1, int offset = 0, const QString &statusFilter = QString());
+    int getTournamentCount(const QString &statusFilter = QString());
     bool updateTournament(const Tournament &tournament);
     bool deleteTournament(int id);
     bool startTournament(int id);
@@ -78,14 +183,153 @@ public:
     bool saveTournamentResults(int tournamentId, const QList<TournamentResult> &results);
     QList<TournamentResult> getTournamentResults(int tournamentId);
 
+    // Points and win/loss/draw counts kept current by triggers on matches,
+    // ranked by points then name, without tiebreakers. One indexed read
+    // instead of a pass over every match.
+    QList<PlayerStanding> getStandings(int tournamentId);
+
     // Utility methods
     bool initializeSchema();
     bool resetDatabase(int tournamentId);
     bool removeTournament(int tournamentId);
+    QString getDatabasePath() const;
+    static QString defaultDatabasePath();
+
+    // URI of a named in-memory database shared by every connection in this
+    // process that opens it; it lives as long as one of them stays open
+    static QString inMemoryPath(const QString &name);
+    bool isInMemory() const;
+
+    // Copy this whole database over the destination. Uses the SQLite online
+    // backup API when available: a negative pagesPerStep copies everything in
+    // one step, otherwise the source is released for stepPauseMs between
+    // steps so other connections can keep writing.
+    bool copyTo(Database &destination, int pagesPerStep = -1, int stepPauseMs = 0);
+
+    // Run PRAGMA quick_check; true when no corruption was found
+    bool quickCheck();
+
+    // PRAGMA data_version: changes whenever another connection commits to
+    // this database, including one sharing its in-memory cache. -1 on failure.
+    int getDataVersion();
+
+    // Idle-time upkeep: refresh the query planner's statistics, then give
+    // free pages back to the file system with incremental_vacuum until the
+    // budget runs out or isCanceled returns true. Cannot run in a transaction.
+    MaintenanceReport runMaintenance(int budgetMs, const std::function<bool()> &isCanceled = std::function<bool()>());
+
+    // Per-tournament files. In the split layout this file is a catalog of
+    // players and tournaments, and each tournament's roster, matches,
+    // standings and results live in a file of their own, attached as
+    // "event" while that tournament is being used.
+    bool isSplitLayout() const;
+    // Move every tournament into its own file and drop its tables from this one
+    bool convertToSplitLayout();
+    // Attach the tournament's file. Tournament methods attach it themselves,
+    // but ATTACH cannot run inside a transaction, so call this before one
+    // that spans several calls. Always true in the single-file layout.
+    bool attachTournament(int tournamentId);
+    QString getTournamentDirectory() const;
+    static QString tournamentDirectoryFor(const QString &databasePath);
+    QString getTournamentFilePath(int tournamentId);
+    QList<int> getTournamentFileIds();
+
+    // Check the schema and load the first tournament on a private connection,
+    // so it can run on a worker thread while the GUI starts up
+    static StartupSnapshot loadStartupSnapshot(const QString &databasePath);
+
+    // Bulk readers (matches, players, results) decode rows straight from the
+    // SQLite C API when the driver's native handle is usable, skipping a
+    // QVariant per column. Disable to force the QtSql path.
+    void setNativeDecoding(bool enabled);
+    bool isNativeDecodingAvailable() const;
+
+    // Per-statement timings of every query run on this connection, and on
+    // every other connection handed the same sink with setQueryStats()
+    const QueryStats &getQueryStats() const;
+    std::shared_ptr<QueryStats> getSharedQueryStats() const;
+    void setQueryStats(const std::shared_ptr<QueryStats> &stats);
+    void resetQueryStats();
 
 private:
+    bool migrateSchema();
+    bool createPlayerSearchIndex();
+    bool createTournamentTables(const QString &schema); // Schema is "main" or "event"
+    bool detachTournament();
+    bool removeTournamentFile(int tournamentId);
+    void removeOrphanedTournamentFiles();
+    int pragmaValue(const QString &pragma); // -1 on failure
+
+    // Maintenance limits: rows sampled per index by ANALYZE, days before the
+    // statistics are gathered again, pages freed per committed chunk, the
+    // assumed rewrite speed of a full VACUUM and the number of log rows kept
+    static const int AnalysisRowLimit = 1000;
+    static const int AnalyzeIntervalDays = 7;
+    static const int VacuumPagesPerChunk = 256;
+    static const int VacuumBytesPerMs = 20000;
+    static const int MaintenanceLogSize = 100;
+
+    // Fallback for copyTo(): rebuild this database from an attached copy
+    bool replaceWithCopyOf(const QString &sourcePath);
+
+    // Run queries through these so they are counted in queryStats
+    bool exec(QSqlQuery &query);
+    bool exec(QSqlQuery &query, const QString &sql);
+    bool next(QSqlQuery &query);
+    // After a failed exec: true once the shared cache of an in-memory
+    // database had a table locked and was waited for, so exec can be retried
+    bool waitForTableLock(const QSqlQuery &query, const QElapsedTimer &timer) const;
+    void recordStatement(const QSqlQuery &query, qint64 durationNs);
+
+    // Hot statements stay prepared for the lifetime of the connection, keyed
+    // by their SQL text. Hold a QueryReset while using one, so it is reset
+    // afterwards and keeps no read transaction open between calls.
+    QSqlQuery &cachedQuery(const QString &sql);
+    void clearStatementCache();
+
+    class QueryReset
+    {
+    public:
+        explicit QueryReset(QSqlQuery &query) : query(query) {}
+        ~QueryReset() { query.finish(); }
+
+    private:
+        QSqlQuery &query;
+    };
+
+    struct CachedStatement
+    {
+        QSqlQuery query;
+        bool prepared;
+    };
+
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    // The driver's handle, or nullptr unless it belongs to the linked SQLite
+    sqlite3 *sqliteHandle() const;
+    // Native handle for the fast path, or nullptr to use QtSql
+    sqlite3 *nativeHandle() const;
+    sqlite3_stmt *nativeStatement(sqlite3 *handle, const QString &sql); // Cached like cachedQuery()
+    void recordNativeStatement(const QString &sql, qint64 durationNs, qint64 rowsReturned);
+#endif
+
     QSqlDatabase db;
     QString dbPath;
+    QString connectionName;
+    AccessMode accessMode;
+    int transactionDepth;
+    bool transactionFailed;
+    bool nativeDecoding;
+    bool splitLayout;
+    bool playerSearchIndex; // players_fts exists and can be queried; searchPlayers() scans otherwise
+    int attachedTournamentId; // Tournament whose file is attached as "event", or -1
+    std::shared_ptr<QueryStats> queryStats;
+    QString countedSql;               // Statement next() last counted a row for
+    QueryStats::Handle countedHandle; // Its queryStats handle
+    QHash<QString, CachedStatement *> statementCache;
+#ifdef OPENTOURNAMENT_HAVE_SQLITE3
+    QHash<QString, sqlite3_stmt *> nativeStatements;
+    bool sameSqlite = false; // Qt's driver uses the linked SQLite; checked by open()
+#endif
 };
 
 #endif // DATABASE_H
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include <QtTest/QtTest>
+#include <QRandomGenerator>
+#include <algorithm>
+
+#include "EngineBench.h"
+#include "Database.h"
+#include "Pairing.h"
+#include "Standings.h"
+#include "Tiebreaker.h"
+
+// Rounds played in every synthetic tournament
+static const int SyntheticRounds = 5;
+
+void EngineBench::initTestCase()
+{
+    QVERIFY(tempDir.isValid());
+}
+
+void EngineBench::addPlayerCountRows()
+{
+    QTest::addColumn<int>("playerCount");
+
+    QTest::newRow("P=16") << 16;
+    QTest::newRow("P=128") << 128;
+    QTest::newRow("P=1024") << 1024;
+    QTest::newRow("P=8192") << 8192;
+}
+
+const EngineBench::Fixture &EngineBench::fixture(int playerCount)
+{
+    auto it = fixtures.constFind(playerCount);
+    if (it != fixtures.constEnd())
+    {
+        return it.value();
+    }
+
+    // Fixed seed so every run measures the same data
+    QRandomGenerator random(playerCount);
+    Fixture data;
+
+    QList<int> order;
+    for (int i = 1; i <= playerCount; ++i)
+    {
+        data.players.append(Player(i, QString("Player %1").arg(i, 5, 10, QChar('0'))));
+        order.append(i);
+    }
+
+    static const char *results[] = {"p1", "p2", "draw"};
+    int matchId = 1;
+    for (int round = 1; round <= SyntheticRounds; ++round)
+    {
+        std::shuffle(order.begin(), order.end(), random);
+        for (int i = 0; i + 1 < order.size(); i += 2)
+        {
+            data.matches.append(Match(matchId++, 1, round, order[i], order[i + 1],
+                                      results[random.bounded(3)], true));
+        }
+    }
+
+    return fixtures.insert(playerCount, data).value();
+}
+
+void EngineBench::benchBuchholzCutOne_data()
+{
+    addPlayerCountRows();
+}
+
+void EngineBench::benchBuchholzCutOne()
+{
+    QFETCH(int, playerCount);
+    const Fixture &data = fixture(playerCount);
+    const Player &player = data.players.at(playerCount / 2);
+
+    double score = 0.0;
+    QBENCHMARK
+    {
+        score = Tiebreaker::calculateBuchholzCutOne(player, data.players, data.matches);
+    }
+    QVERIFY(score >= 0.0);
+}
+
+void EngineBench::benchSonnebornBerger_data()
+{
+    addPlayerCountRows();
+}
+
+void EngineBench::benchSonnebornBerger()
+{
+    QFETCH(int, playerCount);
+    const Fixture &data = fixture(playerCount);
+    const Player &player = data.players.at(playerCount / 2);
+
+    double score = 0.0;
+    QBENCHMARK
+    {
+        score = Tiebreaker::calculateSonnebornBerger(player, data.players, data.matches);
+    }
+    QVERIFY(score >= 0.0);
+}
+
+void EngineBench::benchCumulativeOpponentScore_data()
+{
+    addPlayerCountRows();
+}
+
+void EngineBench::benchCumulativeOpponentScore()
+{
+    QFETCH(int, playerCount);
+    const Fixture &data = fixture(playerCount);
+    const Player &player = data.players.at(playerCount / 2);
+
+    double score = 0.0;
+    QBENCHMARK
+    {
+        score = Tiebreaker::calculateCumulativeOpponentScore(player, data.players, data.matches);
+    }
+    QVERIFY(score >= 0.0);
+}
+
+void EngineBench::benchStandings_data()
+{
+    addPlayerCountRows();
+}
+
+void EngineBench::benchStandings()
+{
+    QFETCH(int, playerCount);
+    const Fixture &data = fixture(playerCount);
+
+    StandingsSnapshot snapshot;
+    snapshot.tournamentId = 1;
+    snapshot.players = data.players;
+    snapshot.matches = data.matches;
+    snapshot.computeTiebreakers = true;
+    snapshot.useSeriesTiebreakers = true;
+    snapshot.seriesTiebreakers = {Tiebreaker::BuchholzCutOne, Tiebreaker::SonnebornBerger,
+                                  Tiebreaker::NumberOfWins, Tiebreaker::CumulativeOpponentScore};
+
+    QList<PlayerStanding> standings;
+    QBENCHMARK
+    {
+        standings = Standings::compute(snapshot);
+    }
+    QCOMPARE(standings.size(), playerCount);
+}
+
+void EngineBench::benchSwissRound_data()
+{
+    addPlayerCountRows();
+}
+
+void EngineBench::benchSwissRound()
+{
+    QFETCH(int, playerCount);
+    const Fixture &data = fixture(playerCount);
+
+    QList<SwissPair> pairs;
+    QBENCHMARK
+    {
+        QList<SwissPlayer> standings = Pairing::calculateStandings(data.players, data.matches);
+        pairs = Pairing::generateSwissRound(standings);
+    }
+    QVERIFY(!pairs.isEmpty());
+}
+
+void EngineBench::benchRoundRobinPairings_data()
+{
+    addPlayerCountRows();
+}
+
+void EngineBench::benchRoundRobinPairings()
+{
+    QFETCH(int, playerCount);
+
+    // A full schedule is P^2 / 2 pairings; 8,192 players would need tens of millions
+    if (playerCount > 1024)
+    {
+        QSKIP("Round-robin schedule is too large to hold in memory at this size");
+    }
+
+    const Fixture &data = fixture(playerCount);
+
+    QList<QList<SwissPair>> rounds;
+    QBENCHMARK
+    {
+        rounds = Pairing::roundRobinPairings(data.players);
+    }
+    QCOMPARE(rounds.size(), playerCount - 1);
+}
+
+void EngineBench::benchDatabaseInsert_data()
+{
+    addPlayerCountRows();
+}
+
+void EngineBench::benchDatabaseInsert()
+{
+    QFETCH(int, playerCount);
+    const Fixture &data = fixture(playerCount);
+
+    // Inserting changes the database, so each row is measured once on a fresh file
+    QString path = tempDir.filePath(QString("insert_%1.db").arg(playerCount));
+    Database database(path, QString("bench_insert_%1").arg(playerCount));
+    QVERIFY(database.connect());
+
+    int tournamentId = -1;
+    QBENCHMARK_ONCE
+    {
+        tournamentId = populate(database, data);
+    }
+    QVERIFY(tournamentId != -1);
+}
+
+void EngineBench::benchDatabaseLoad_data()
+{
+    // Each size is decoded through QtSql and through the SQLite C API
+    QTest::addColumn<int>("playerCount");
+    QTest::addColumn<bool>("nativeDecoding");
+
+    for (int playerCount : {16, 128, 1024, 8192})
+    {
+        QTest::addRow("P=%d qtsql", playerCount) << playerCount << false;
+        QTest::addRow("P=%d native", playerCount) << playerCount << true;
+    }
+}
+
+void EngineBench::benchDatabaseLoad()
+{
+    QFETCH(int, playerCount);
+    QFETCH(bool, nativeDecoding);
+    const Fixture &data = fixture(playerCount);
+
+    QString path = tempDir.filePath(QString("load_%1_%2.db").arg(playerCount).arg(nativeDecoding));
+    Database database(path, QString("bench_load_%1_%2").arg(playerCount).arg(nativeDecoding));
+    QVERIFY(database.connect());
+
+    database.setNativeDecoding(nativeDecoding);
+    if (nativeDecoding && !database.isNativeDecodingAvailable())
+    {
+        QSKIP("Built without the SQLite C API");
+    }
+
+    // Populate outside the measured block
+    int tournamentId = populate(database, data);
+    QVERIFY(tournamentId != -1);
+
+    QList<Player> players;
+    QList<Match> matches;
+    QBENCHMARK
+    {
+        players = database.getPlayersForTournament(tournamentId);
+        matches = database.getAllMatches(tournamentId);
+    }
+    QCOMPARE(players.size(), playerCount);
+    QCOMPARE(matches.size(), data.matches.size());
+}
+
+void EngineBench::benchMatchScan_data()
+{
+    addPlayerCountRows();
+}
+
+void EngineBench::benchMatchScan()
+{
+    QFETCH(int, playerCount);
+    const Fixture &data = fixture(playerCount);
+
+    QString path = tempDir.filePath(QString("scan_%1.db").arg(playerCount));
+    Database database(path, QString("bench_scan_%1").arg(playerCount));
+    QVERIFY(database.connect());
+
+    int tournamentId = populate(database, data);
+    QVERIFY(tournamentId != -1);
+
+    // Same rows as benchDatabaseLoad's match query, streamed instead of listed
+    int rounds = 0;
+    int visited = 0;
+    QBENCHMARK
+    {
+        rounds = 0;
+        visited = database.forEachMatch(tournamentId, [&rounds](const MatchRecord &match)
+                                        {
+            rounds = qMax(rounds, match.round);
+            return true; });
+    }
+    QCOMPARE(visited, data.matches.size());
+    QVERIFY(rounds > 0);
+}
+
+// Matches are added with the fixture's player ids. They only equal the ids
+// the database assigns because every benchmark populates a fresh file, in
+// which players are numbered from 1 in fixture order.
+int EngineBench::populate(Database &database, const Fixture &data)
+{
+    int tournamentId = database.addTournament("Benchmark");
+    database.beginTransaction();
+    for (const Player &player : data.players)
+    {
+        database.addPlayerToTournament(player.getName(), tournamentId);
+    }
+    for (const Match &match : data.matches)
+    {
+        database.addMatch(tournamentId, match.getRound(), match.getPlayer1Id(), match.getPlayer2Id());
+    }
+
+    return database.commitTransaction() ? tournamentId : -1;
+}
+
+QTEST_GUILESS_MAIN(EngineBench)
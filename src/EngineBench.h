@@ -0,0 +1,54 @@
+#ifndef ENGINEBENCH_H
+#define ENGINEBENCH_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QTemporaryDir>
+#include "Player.h"
+#include "Match.h"
+
+class Database;
+
+class EngineBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void benchBuchholzCutOne_data();
+    void benchBuchholzCutOne();
+    void benchSonnebornBerger_data();
+    void benchSonnebornBerger();
+    void benchCumulativeOpponentScore_data();
+    void benchCumulativeOpponentScore();
+    void benchStandings_data();
+    void benchStandings();
+    void benchSwissRound_data();
+    void benchSwissRound();
+    void benchRoundRobinPairings_data();
+    void benchRoundRobinPairings();
+    void benchDatabaseInsert_data();
+    void benchDatabaseInsert();
+    void benchDatabaseLoad_data();
+    void benchDatabaseLoad();
+    void benchMatchScan_data();
+    void benchMatchScan();
+
+private:
+    // Synthetic tournament: P players and a few played Swiss-style rounds
+    struct Fixture
+    {
+        QList<Player> players;
+        QList<Match> matches;
+    };
+
+    void addPlayerCountRows();
+    const Fixture &fixture(int playerCount);
+    int populate(Database &database, const Fixture &data); // Into a fresh file only; returns the tournament id or -1
+
+    QHash<int, Fixture> fixtures;
+    QTemporaryDir tempDir;
+};
+
+#endif // ENGINEBENCH_H
@@ -0,0 +1,152 @@
+#include "InMemoryDatabase.h"
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QFile>
+#include <QDebug>
+#include "Database.h"
+#include "Trace.h"
+
+InMemoryDatabase::InMemoryDatabase(const QString &diskPath, int persistIntervalMs, QObject *parent)
+    : QThread(parent), diskPath(diskPath.isEmpty() ? Database::defaultDatabasePath() : diskPath),
+      persistIntervalMs(persistIntervalMs), stopping(false), persistRequested(false),
+      loadFinished(false), loadSucceeded(false)
+{
+    // Each instance needs its own connections and its own in-memory database
+    static QAtomicInt nextInstance;
+    connectionName = QString("memory_%1").arg(nextInstance.fetchAndAddRelaxed(1));
+    memoryPath = Database::inMemoryPath("opentournament_" + connectionName);
+}
+
+InMemoryDatabase::~InMemoryDatabase()
+{
+    stop();
+}
+
+bool InMemoryDatabase::open()
+{
+    start();
+    return waitForLoad();
+}
+
+bool InMemoryDatabase::waitForLoad()
+{
+    QMutexLocker locker(&mutex);
+    while (!loadFinished)
+    {
+        stateChanged.wait(&mutex);
+    }
+
+    return loadSucceeded;
+}
+
+void InMemoryDatabase::persistNow()
+{
+    QMutexLocker locker(&mutex);
+    persistRequested = true;
+    stateChanged.wakeAll();
+}
+
+void InMemoryDatabase::stop()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        stateChanged.wakeAll();
+    }
+
+    wait();
+}
+
+QString InMemoryDatabase::getDatabasePath() const
+{
+    return memoryPath;
+}
+
+QString InMemoryDatabase::getDiskPath() const
+{
+    return diskPath;
+}
+
+bool InMemoryDatabase::canHold(const QString &diskPath)
+{
+    QString path = diskPath.isEmpty() ? Database::defaultDatabasePath() : diskPath;
+    if (!QFile::exists(path))
+    {
+        return true;
+    }
+
+    static QAtomicInt nextProbe;
+    Database probe(path, QString("memory_probe_%1").arg(nextProbe.fetchAndAddRelaxed(1)), Database::ReadOnly);
+    return !probe.open() || !probe.isSplitLayout();
+}
+
+void InMemoryDatabase::run()
+{
+    // Both connections live on this thread; the memory connection also keeps
+    // the in-memory database alive until the worker stops
+    Database memory(memoryPath, connectionName + "_memory");
+    Database disk(diskPath, connectionName + "_disk");
+
+    // A split catalog cannot be held in memory; callers check canHold() first
+    bool ok = memory.open() && disk.open() && !disk.isSplitLayout() && disk.copyTo(memory);
+
+    {
+        QMutexLocker locker(&mutex);
+        loadFinished = true;
+        loadSucceeded = ok;
+        stateChanged.wakeAll();
+    }
+
+    if (!ok)
+    {
+        qDebug() << "Failed to load" << diskPath << "into memory";
+        return;
+    }
+
+    // The memory connection itself never writes after the load, so its data
+    // version only moves when another connection commits a change
+    int persistedVersion = memory.getDataVersion();
+
+    forever
+    {
+        bool finalCopy;
+        {
+            QMutexLocker locker(&mutex);
+            if (!stopping && !persistRequested)
+            {
+                stateChanged.wait(&mutex, persistIntervalMs);
+            }
+            finalCopy = stopping;
+            persistRequested = false;
+        }
+
+        // Nothing to write when nothing was committed since the last copy.
+        // The version is read first, so a commit during the copy is written
+        // again next time.
+        int version = memory.getDataVersion();
+        if (version != -1 && version == persistedVersion)
+        {
+            if (finalCopy)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // The last copy runs in one step since nothing else is writing by then
+        OT_TRACE_SCOPE("InMemoryDatabase::persist");
+        if (memory.copyTo(disk, finalCopy ? -1 : PagesPerStep, finalCopy ? 0 : StepPauseMs))
+        {
+            persistedVersion = version;
+        }
+        else
+        {
+            qDebug() << "Failed to persist in-memory database to" << diskPath;
+        }
+
+        if (finalCopy)
+        {
+            break;
+        }
+    }
+}
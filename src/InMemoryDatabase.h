@@ -0,0 +1,60 @@
+#ifndef INMEMORYDATABASE_H
+#define INMEMORYDATABASE_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QString>
+
+// Keeps the working database in memory so writes cost no disk I/O. The file
+// is loaded into a shared in-memory database when the worker starts, then
+// copied back page by page every persist interval and once more on stop,
+// skipping intervals in which nothing was committed, so at most one
+// interval of changes can be lost. Other connections open
+// getDatabasePath() exactly as they would open the file.
+class InMemoryDatabase : public QThread
+{
+public:
+    explicit InMemoryDatabase(const QString &diskPath, int persistIntervalMs = 10000, QObject *parent = nullptr);
+    ~InMemoryDatabase() override;
+
+    // Start the worker and wait until the file has been loaded
+    bool open();
+
+    // Wait for a worker started with start() to finish loading
+    bool waitForLoad();
+
+    // Copy the database back to disk now instead of at the next interval
+    void persistNow();
+
+    // Persist one last time, then stop the worker and release the memory
+    void stop();
+
+    QString getDatabasePath() const; // URI of the in-memory database
+    QString getDiskPath() const;
+
+    // False for a split catalog, whose tournament files have to stay on disk
+    static bool canHold(const QString &diskPath);
+
+protected:
+    void run() override;
+
+private:
+    // Pages copied per backup step while connections are still writing
+    static const int PagesPerStep = 64;
+    static const int StepPauseMs = 2;
+
+    QString diskPath;
+    QString memoryPath;
+    QString connectionName;
+    int persistIntervalMs;
+
+    QMutex mutex;
+    QWaitCondition stateChanged;
+    bool stopping;
+    bool persistRequested;
+    bool loadFinished;
+    bool loadSucceeded;
+};
+
+#endif // INMEMORYDATABASE_H
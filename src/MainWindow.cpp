@@ -13,6 +13,7 @@
 #include <QDateTime>
 #include <QTextStream>
 #include <QFile>
+#include <QFileInfo>
 #include <QVBoxLayout>
 #include <QPushButton>
 void setAbyssTheme(QApplication &app)
@@ -43,6 +44,18 @@ void setDarkHighContrastTheme(QApplication &app)
 #include <QComboBox>
 #include <QLabel>
 #include <QSpinBox>
+#include <QKeySequence>
+#include <QFont>
+#include <QSignalBlocker>
+#include <QTimer>
+#include <QEvent>
+#include <QCompleter>
+#include <QStringListModel>
+#include <QtConcurrent/QtConcurrent>
+#include "StartupTimer.h"
+#include "Pairing.h"
+#include "Trace.h"
+#include "RosterImporter.h"
 #include <algorithm>
 #include <vector>
 #include <string>
@@ -56,33 +69,230 @@ void setFusionWhite(QApplication &app);
 void setAbyssTheme(QApplication &app);
 void setDarkHighContrastTheme(QApplication &app);
 
+// Describe a match result for display in the round tables
+static QString describeResult(const QString &result, const QString &p1Name, const QString &p2Name)
+{
+    if (result == "p1")
+    {
+        return p1Name + " Wins";
+    }
+    else if (result == "p2")
+    {
+        return p2Name + " Wins";
+    }
+    else if (result == "draw")
+    {
+        return "Draw";
+    }
+
+    return "Not Played";
+}
+
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), database(new Database()), settings(new Settings()), app(qApp)
+    : QMainWindow(parent), database(nullptr), settings(new Settings()),
+      standingsCalculator(new StandingsCalculator(this)), batchEntry(new BatchEntry()),
+      asyncDatabase(nullptr), readPool(nullptr), inMemoryDatabase(nullptr), backupManager(nullptr),
+      maintenanceScheduler(nullptr), inMemoryUnavailable(false), batchCommitPending(false),
+      currentRoundTabIndex(-1), searchResultPosition(0),
+      performanceLabel(nullptr), refreshQueryBaseline(0), refreshRowBaseline(0), cellsRebuilt(0), lastStandingsMs(0),
+      startupWatcher(new QFutureWatcher<StartupSnapshot>(this)), firstFramePainted(false), startupLoaded(false),
+      app(qApp)
+{
+    // Standings are computed off the GUI thread and delivered back here
+    connect(standingsCalculator, &StandingsCalculator::standingsReady, this, &MainWindow::onStandingsReady);
+    connect(standingsCalculator, &StandingsCalculator::standingsFailed, this, &MainWindow::onStandingsFailed);
+
+    // Load settings
+    settings->load();
+
+    // Every connection opens the in-memory copy when enabled; the startup
+    // worker below waits for the file to be loaded into it. A split catalog
+    // keeps its tournaments on disk, so it is used as a file instead.
+    inMemoryUnavailable = settings->getInMemoryDatabase() && !InMemoryDatabase::canHold(Database::defaultDatabasePath());
+    if (settings->getInMemoryDatabase() && !inMemoryUnavailable)
+    {
+        inMemoryDatabase = new InMemoryDatabase(Database::defaultDatabasePath(),
+                                                settings->getPersistIntervalSeconds() * 1000);
+        inMemoryDatabase->start();
+    }
+
+    database = new Database(inMemoryDatabase ? inMemoryDatabase->getDatabasePath() : QString());
+    // Result writes run on the worker; its statements belong in the diagnostics too
+    asyncDatabase = new AsyncDatabase(database->getDatabasePath(), database->getSharedQueryStats());
+    // Standings and exports run on pool connections; count them with the
+    // main connection's statements so the HUD and diagnostics see them
+    readPool = new ReadPool(database->getDatabasePath(), database->getSharedQueryStats());
+    standingsCalculator->setReadPool(readPool);
+
+    // Backups read the live database, so in memory mode they include
+    // changes not yet saved to the file
+    backupManager = new BackupManager(database->getDatabasePath(), BackupManager::defaultBackupDirectory());
+    backupManager->setSchedule(settings->getBackupIntervalMinutes(), settings->getBackupKeepCount());
+
+    // Maintenance waits for the user to leave the application alone; every
+    // input event anywhere in it restarts the wait
+    maintenanceScheduler = new MaintenanceScheduler(database->getDatabasePath());
+    maintenanceScheduler->setIdleMinutes(settings->getMaintenanceIdleMinutes());
+    qApp->installEventFilter(this);
+
+    setupUI();
+
+    // Keep the controls disabled until the database is ready
+    toolBar->setEnabled(false);
+    exportResultsAction->setEnabled(false);
+    backupNowAction->setEnabled(false);
+    restoreBackupAction->setEnabled(false);
+    importRosterAction->setEnabled(false);
+    batchModeAction->setEnabled(false);
+
+    // Check the schema and load the first tournament on a worker so the window
+    // paints immediately; onStartupSnapshotLoaded() fills it in afterwards
+    connect(startupWatcher, &QFutureWatcher<StartupSnapshot>::finished, this, &MainWindow::onStartupSnapshotLoaded);
+    startupWatcher->setFuture(QtConcurrent::run([memory = inMemoryDatabase, path = database->getDatabasePath()]()
+                                                {
+        if (memory && !memory->waitForLoad())
+        {
+            return StartupSnapshot();
+        }
+        return Database::loadStartupSnapshot(path); }));
+
+    // Set initial status
+    mainStatusBar->showMessage("Loading tournaments...");
+}
+
+void MainWindow::onStartupSnapshotLoaded()
 {
+    StartupSnapshot snapshot = startupWatcher->result();
+    StartupTimer::record("Database open and schema check", snapshot.schemaMs);
+    StartupTimer::record("First tournament load", snapshot.loadMs);
+
     // Connect to database
-    if (!database->connect())
+    if (!snapshot.schemaReady || !database->open() || !asyncDatabase->open())
     {
         QMessageBox::critical(this, "Database Error",
                               "Failed to connect to database. The application will exit.");
         QApplication::exit(1);
+        return;
     }
 
-    // Load settings
-    settings->load();
+    applyStartupSnapshot(snapshot);
 
-    setupUI();
-    populateTournamentSelector();
-    updatePlayerList();
-    updateMatchTabs();
+    // The schema exists now, so backups and maintenance can start
+    backupManager->start();
+    maintenanceScheduler->start();
+
+    toolBar->setEnabled(true);
+    exportResultsAction->setEnabled(true);
+    backupNowAction->setEnabled(true);
+    restoreBackupAction->setEnabled(true);
+    importRosterAction->setEnabled(true);
+    batchModeAction->setEnabled(true);
+
+    startupLoaded = true;
+    StartupTimer::mark("First tournament shown");
+    if (firstFramePainted)
+    {
+        StartupTimer::report();
+    }
 
     // Set initial status
     mainStatusBar->showMessage("Ready");
+
+    if (inMemoryUnavailable)
+    {
+        QMessageBox::warning(this, "In-Memory Database",
+                             "Tournaments are kept in their own files, so the database cannot be held in memory. "
+                             "It is used from disk instead; turn off the in-memory setting to hide this message.");
+    }
+
+    // Offer to restore results staged before an unexpected exit
+    restoreStagedResults();
+}
+
+void MainWindow::applyStartupSnapshot(const StartupSnapshot &snapshot)
+{
+    // A fresh database starts with a default tournament
+    if (snapshot.tournaments.isEmpty())
+    {
+        database->addTournament("Default Tournament");
+        populateTournamentSelector();
+        return;
+    }
+
+    // Fill the selector without reloading the tournament for every item
+    {
+        QSignalBlocker blocker(tournamentSelector);
+        tournamentSelector->clear();
+        for (const TournamentCatalogEntry &entry : snapshot.tournaments)
+        {
+            tournamentSelector->addItem(entry.name, entry.id);
+        }
+        tournamentSelector->setCurrentIndex(0);
+    }
+
+    // Show the first tournament straight from the snapshot
+    const Tournament &tournament = snapshot.tournament;
+
+    QHash<int, QString> playerNames;
+    for (const Player &player : snapshot.players)
+    {
+        playerNames.insert(player.getId(), player.getName());
+    }
+
+    buildMatchTabs(tournament, snapshot.matches, playerNames);
+    standingsCalculator->request(createStandingsSnapshot(snapshot.tournamentId, snapshot.players, snapshot.matches, false),
+                                 StandingsCalculator::Leaderboard);
+    updateTournamentControls(tournament);
+}
+
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type())
+    {
+    case QEvent::KeyPress:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+        maintenanceScheduler->userActive();
+        break;
+    default:
+        break;
+    }
+
+    return QMainWindow::eventFilter(watched, event);
+}
+
+void MainWindow::paintEvent(QPaintEvent *event)
+{
+    QMainWindow::paintEvent(event);
+
+    if (!firstFramePainted)
+    {
+        firstFramePainted = true;
+        StartupTimer::mark("First frame painted");
+        if (startupLoaded)
+        {
+            StartupTimer::report();
+        }
+    }
 }
 
 MainWindow::~MainWindow()
 {
+    // Finish queued writes, backups, maintenance and worker reads before the connections go away
+    delete asyncDatabase;
+    delete backupManager;
+    qApp->removeEventFilter(this);
+    delete maintenanceScheduler;
+    standingsCalculator->cancelAll();
+    QThreadPool::globalInstance()->waitForDone();
+    delete readPool;
     delete database;
+
+    // Nothing else is connected now, so the final copy to disk is complete
+    delete inMemoryDatabase;
     delete settings;
+    delete batchEntry;
 }
 
 void MainWindow::setupUI()
@@ -92,6 +302,7 @@ void MainWindow::setupUI()
 
     setupMenu();
     setupToolbar();
+    setupBatchToolbar();
     setupPlayerPanel();
     setupMatchPanel();
 
@@ -106,6 +317,11 @@ void MainWindow::setupUI()
 
     setCentralWidget(splitter);
     setStatusBar(mainStatusBar);
+
+    // Performance HUD, hidden unless enabled in the Settings menu
+    performanceLabel = new QLabel(this);
+    mainStatusBar->addPermanentWidget(performanceLabel);
+    performanceLabel->setVisible(settings->getShowPerformanceHud());
 }
 
 void MainWindow::setupMenu()
@@ -115,11 +331,21 @@ void MainWindow::setupMenu()
 
     // File menu
     QMenu *fileMenu = menuBar->addMenu("&File");
+    importRosterAction = fileMenu->addAction("&Import Roster...");
     exportResultsAction = fileMenu->addAction("&Export Results");
+    backupNowAction = fileMenu->addAction("Back &Up Now");
+    restoreBackupAction = fileMenu->addAction("&Restore Backup...");
+    batchModeAction = fileMenu->addAction("&Batch Result Entry");
+    batchModeAction->setCheckable(true);
+    batchModeAction->setShortcut(QKeySequence("Ctrl+B"));
     fileMenu->addSeparator();
     exitAction = fileMenu->addAction("E&xit");
 
+    connect(importRosterAction, &QAction::triggered, this, &MainWindow::onImportRosterClicked);
     connect(exportResultsAction, &QAction::triggered, this, &MainWindow::onExportResultsClicked);
+    connect(backupNowAction, &QAction::triggered, this, &MainWindow::onBackupNowClicked);
+    connect(restoreBackupAction, &QAction::triggered, this, &MainWindow::onRestoreBackupClicked);
+    connect(batchModeAction, &QAction::toggled, this, &MainWindow::onBatchModeToggled);
     connect(exitAction, &QAction::triggered, this, &QMainWindow::close);
 
     // Themes menu
@@ -148,9 +374,15 @@ void MainWindow::setupMenu()
     QMenu *settingsMenu = menuBar->addMenu("&Settings");
     settingsAction = settingsMenu->addAction("&Preferences");
     connect(settingsAction, &QAction::triggered, this, &MainWindow::showSettingsDialog);
+    performanceHudAction = settingsMenu->addAction("Show &Performance HUD");
+    performanceHudAction->setCheckable(true);
+    performanceHudAction->setChecked(settings->getShowPerformanceHud());
+    connect(performanceHudAction, &QAction::toggled, this, &MainWindow::onPerformanceHudToggled);
 
     // Help menu
     QMenu *helpMenu = menuBar->addMenu("&Help");
+    diagnosticsAction = helpMenu->addAction("&Diagnostics");
+    connect(diagnosticsAction, &QAction::triggered, this, &MainWindow::showDiagnosticsDialog);
     aboutAction = helpMenu->addAction("&About");
     connect(aboutAction, &QAction::triggered, [this]()
             {
@@ -185,6 +417,119 @@ void MainWindow::setupMenu()
             });
 }
 
+void MainWindow::onPerformanceHudToggled(bool checked)
+{
+    settings->setShowPerformanceHud(checked);
+    settings->save();
+
+    performanceLabel->setVisible(checked);
+    performanceLabel->setText(checked ? "Waiting for next refresh..." : QString());
+    refreshTimer.invalidate();
+}
+
+void MainWindow::beginRefreshMeasurement()
+{
+    // Several refresh paths usually run for one click; measure them together
+    if (!performanceLabel->isVisible() || refreshTimer.isValid())
+        return;
+
+    refreshTimer.start();
+    refreshQueryBaseline = database->getQueryStats().totalCalls();
+    refreshRowBaseline = database->getQueryStats().totalRowsReturned();
+    cellsRebuilt = 0;
+}
+
+void MainWindow::finishRefreshMeasurement()
+{
+    // Include pending standings in the measurement once they arrive
+    if (!refreshTimer.isValid() || standingsCalculator->isBusy(StandingsCalculator::Leaderboard))
+        return;
+
+    const QueryStats &stats = database->getQueryStats();
+    performanceLabel->setText(QString("Refresh %1 ms | %2 queries, %3 rows | %4 cells rebuilt | standings %5 ms")
+                                  .arg(refreshTimer.elapsed())
+                                  .arg(qMax<qint64>(0, stats.totalCalls() - refreshQueryBaseline))
+                                  .arg(qMax<qint64>(0, stats.totalRowsReturned() - refreshRowBaseline))
+                                  .arg(cellsRebuilt)
+                                  .arg(lastStandingsMs));
+    refreshTimer.invalidate();
+}
+
+void MainWindow::showDiagnosticsDialog()
+{
+    QDialog diagnosticsDialog(this);
+    diagnosticsDialog.setWindowTitle("Diagnostics");
+    diagnosticsDialog.resize(900, 500);
+
+    QVBoxLayout *layout = new QVBoxLayout(&diagnosticsDialog);
+    layout->addWidget(new QLabel("Database statements run since startup on the main and worker connections, slowest total first:",
+                                 &diagnosticsDialog));
+
+    QTableWidget *statsTable = new QTableWidget(0, 7, &diagnosticsDialog);
+    statsTable->setHorizontalHeaderLabels({"Statement", "Calls", "Total (ms)", "p50 (ms)", "p99 (ms)", "Rows Returned", "Rows Affected"});
+    statsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    statsTable->verticalHeader()->setVisible(false);
+    statsTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    layout->addWidget(statsTable);
+
+    auto refresh = [this, statsTable]()
+    {
+        QList<QueryStatement> statements = database->getQueryStats().statements();
+        statsTable->setRowCount(statements.size());
+        for (int row = 0; row < statements.size(); ++row)
+        {
+            const QueryStatement &statement = statements[row];
+            QTableWidgetItem *sqlItem = new QTableWidgetItem(statement.sql.simplified());
+            sqlItem->setToolTip(statement.sql.trimmed());
+            statsTable->setItem(row, 0, sqlItem);
+
+            const QStringList values = {
+                QString::number(statement.calls),
+                QString::number(statement.totalNs / 1e6, 'f', 2),
+                QString::number(statement.p50Ns / 1e6, 'f', 3),
+                QString::number(statement.p99Ns / 1e6, 'f', 3),
+                QString::number(statement.rowsReturned),
+                QString::number(statement.rowsAffected)};
+            for (int column = 0; column < values.size(); ++column)
+            {
+                QTableWidgetItem *item = new QTableWidgetItem(values[column]);
+                item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                statsTable->setItem(row, column + 1, item);
+            }
+        }
+    };
+    refresh();
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, &diagnosticsDialog);
+    QPushButton *refreshButton = buttonBox->addButton("Refresh", QDialogButtonBox::ActionRole);
+    QPushButton *resetButton = buttonBox->addButton("Reset", QDialogButtonBox::ResetRole);
+    QPushButton *saveButton = buttonBox->addButton("Save JSON...", QDialogButtonBox::ActionRole);
+    layout->addWidget(buttonBox);
+
+    connect(buttonBox, &QDialogButtonBox::rejected, &diagnosticsDialog, &QDialog::reject);
+    connect(refreshButton, &QPushButton::clicked, &diagnosticsDialog, refresh);
+    connect(resetButton, &QPushButton::clicked, &diagnosticsDialog, [this, refresh]()
+            {
+                database->resetQueryStats();
+                refresh(); });
+    connect(saveButton, &QPushButton::clicked, &diagnosticsDialog, [this, &diagnosticsDialog]()
+            {
+                QString fileName = QFileDialog::getSaveFileName(&diagnosticsDialog,
+                                                                "Save Query Statistics",
+                                                                "query_stats.json",
+                                                                "JSON Files (*.json)");
+                if (fileName.isEmpty())
+                    return;
+
+                if (!database->getQueryStats().writeJson(fileName))
+                {
+                    QMessageBox::critical(&diagnosticsDialog, "Error", "Failed to save query statistics.");
+                } });
+
+    diagnosticsDialog.exec();
+}
+
 void MainWindow::onFusionDarkSelected()
 {
     setFusionDark(*app);
@@ -270,7 +615,6 @@ void MainWindow::setupToolbar()
     // Tournament selector
     tournamentSelector = new QComboBox(this);
     tournamentSelector->setMinimumWidth(200);
-    populateTournamentSelector();
 
     // Enable context menu for tournament selector
     tournamentSelector->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -297,6 +641,22 @@ void MainWindow::setupToolbar()
     toolBar->addWidget(endTournamentButton);   // Add end tournament button
     toolBar->addWidget(tiebreakerButton);      // Add tiebreaker button
 
+    // Player search box, focused with Ctrl+F
+    playerSearchEdit = new QLineEdit(this);
+    playerSearchEdit->setPlaceholderText("Find player (Ctrl+F)");
+    playerSearchEdit->setClearButtonEnabled(true);
+    playerSearchEdit->setMaximumWidth(200);
+    toolBar->addSeparator();
+    toolBar->addWidget(playerSearchEdit);
+
+    QAction *findAction = new QAction(this);
+    findAction->setShortcut(QKeySequence::Find);
+    addAction(findAction);
+    connect(findAction, &QAction::triggered, [this]()
+            {
+                playerSearchEdit->setFocus();
+                playerSearchEdit->selectAll(); });
+
     connect(tournamentSelector, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::onTournamentSelectionChanged);
     connect(addTournamentButton, &QPushButton::clicked, this, &MainWindow::onAddTournamentClicked);
     connect(addPlayerButton, &QPushButton::clicked, this, &MainWindow::onAddPlayerClicked);
@@ -305,6 +665,278 @@ void MainWindow::setupToolbar()
     connect(startTournamentButton, &QPushButton::clicked, this, &MainWindow::onStartTournamentClicked); // Connect start tournament button
     connect(endTournamentButton, &QPushButton::clicked, this, &MainWindow::onEndTournamentClicked);     // Connect end tournament button
     connect(tiebreakerButton, &QPushButton::clicked, this, &MainWindow::onTiebreakerClicked);           // Connect tiebreaker button
+    connect(playerSearchEdit, &QLineEdit::textEdited, this, &MainWindow::onPlayerSearchTextChanged);
+    connect(playerSearchEdit, &QLineEdit::returnPressed, this, &MainWindow::onPlayerSearchNext);
+}
+
+void MainWindow::setupBatchToolbar()
+{
+    batchToolBar = new QToolBar("Batch Entry", this);
+    addToolBarBreak();
+    addToolBar(batchToolBar);
+
+    // Results are typed as a board number followed by a result key
+    batchEntryEdit = new QLineEdit(this);
+    batchEntryEdit->setPlaceholderText("Board + 1 / 0 / =  (e.g. 121, 70, 3=)");
+    batchEntryEdit->setToolTip("Board number followed by 1 (P1 wins), 0 (P2 wins) or = (draw), then Enter");
+    batchEntryEdit->setMaximumWidth(220);
+
+    batchStatusLabel = new QLabel(this);
+    commitBatchButton = new QPushButton("Commit Batch", this);
+    commitBatchButton->setShortcut(QKeySequence("Ctrl+Return"));
+    discardBatchButton = new QPushButton("Discard", this);
+
+    batchToolBar->addWidget(new QLabel("Batch entry: ", this));
+    batchToolBar->addWidget(batchEntryEdit);
+    batchToolBar->addWidget(batchStatusLabel);
+    batchToolBar->addSeparator();
+    batchToolBar->addWidget(commitBatchButton);
+    batchToolBar->addWidget(discardBatchButton);
+    batchToolBar->setVisible(false);
+
+    connect(batchEntryEdit, &QLineEdit::returnPressed, this, &MainWindow::onBatchEntrySubmitted);
+    connect(commitBatchButton, &QPushButton::clicked, this, &MainWindow::onCommitBatchClicked);
+    connect(discardBatchButton, &QPushButton::clicked, this, &MainWindow::onDiscardBatchClicked);
+
+    updateBatchStatus();
+}
+
+void MainWindow::onBatchModeToggled(bool enabled)
+{
+    batchToolBar->setVisible(enabled);
+
+    if (enabled)
+    {
+        batchEntryEdit->setFocus();
+        mainStatusBar->showMessage("Batch entry: type a board number and result key, then press Enter");
+    }
+}
+
+void MainWindow::onBatchEntrySubmitted()
+{
+    QString text = batchEntryEdit->text().trimmed();
+    batchEntryEdit->clear();
+
+    if (text.isEmpty())
+        return;
+
+    // The last key is the result, the digits before it are the board number
+    QString result = BatchEntry::resultForKey(text.back());
+    bool ok;
+    int board = text.left(text.size() - 1).trimmed().toInt(&ok);
+
+    if (result.isEmpty() || !ok || board < 1)
+    {
+        mainStatusBar->showMessage("Enter a board number followed by 1, 0 or =");
+        return;
+    }
+
+    // Boards are numbered by their row in the selected round
+    QTableWidget *table = qobject_cast<QTableWidget *>(roundTabs->currentWidget());
+    if (!table || board > table->rowCount())
+    {
+        mainStatusBar->showMessage(QString("Board %1 is not in the selected round").arg(board));
+        return;
+    }
+
+    int row = board - 1;
+    QTableWidgetItem *idItem = table->item(row, 0);
+    if (!idItem)
+        return;
+
+    int matchId = idItem->data(Qt::UserRole).toInt();
+    if (idItem->data(Qt::UserRole + 1).toBool())
+    {
+        mainStatusBar->showMessage(QString("Board %1 already has a locked result").arg(board));
+        return;
+    }
+
+    // Results staged for one tournament must be committed before moving on
+    int tournamentId = getCurrentTournamentId();
+    if (!batchEntry->isEmpty() && batchEntry->getTournamentId() != tournamentId)
+    {
+        mainStatusBar->showMessage("Commit or discard the results staged for another tournament first");
+        return;
+    }
+
+    batchEntry->begin(tournamentId);
+    if (!batchEntry->stage(matchId, result))
+    {
+        QMessageBox::critical(this, "Error", "Failed to stage result.");
+        return;
+    }
+
+    // Show the staged result in place instead of rebuilding the round tabs
+    QTableWidgetItem *resultItem = table->item(row, 3);
+    if (resultItem)
+    {
+        QString p1Name = table->item(row, 1) ? table->item(row, 1)->text() : QString();
+        QString p2Name = table->item(row, 2) ? table->item(row, 2)->text() : QString();
+        resultItem->setText("Staged: " + describeResult(result, p1Name, p2Name));
+
+        QFont font = resultItem->font();
+        font.setItalic(true);
+        resultItem->setFont(font);
+    }
+    table->selectRow(row);
+
+    updateBatchStatus();
+    mainStatusBar->showMessage(QString("Board %1 staged").arg(board));
+}
+
+void MainWindow::onCommitBatchClicked()
+{
+    if (batchCommitPending)
+    {
+        return;
+    }
+
+    if (batchEntry->isEmpty())
+    {
+        mainStatusBar->showMessage("No staged results to commit");
+        return;
+    }
+
+    // Write every staged result in one transaction on the async writer, so
+    // the commit never blocks the window or competes with its lock
+    struct Outcome
+    {
+        int committedCount = -1;
+        QList<int> skipped;
+    };
+    auto outcome = std::make_shared<Outcome>();
+    const int tournamentId = batchEntry->getTournamentId();
+    const QMap<int, QString> results = batchEntry->getStagedResults();
+
+    batchCommitPending = true;
+    updateBatchStatus();
+    mainStatusBar->showMessage(QString("Committing %1 results...").arg(results.size()));
+
+    asyncDatabase->write([tournamentId, results, outcome](Database &connection)
+                         {
+        outcome->committedCount = connection.commitResults(tournamentId, results, &outcome->skipped);
+        return outcome->committedCount >= 0; }, tournamentId)
+        .then(this, [this, tournamentId, results, outcome](bool ok)
+              { finishBatchCommit(tournamentId, results, ok ? outcome->committedCount : -1, outcome->skipped); });
+}
+
+void MainWindow::finishBatchCommit(int tournamentId, const QMap<int, QString> &results, int committedCount,
+                                   const QList<int> &skipped)
+{
+    batchCommitPending = false;
+    if (committedCount < 0)
+    {
+        updateBatchStatus();
+        QMessageBox::critical(this, "Error", "Failed to commit staged results. They have been kept so you can try again.");
+        return;
+    }
+
+    // Results staged while the batch was being written stay staged
+    if (batchEntry->getStagedResults() == results)
+    {
+        batchEntry->clear();
+    }
+    else
+    {
+        for (auto it = results.constBegin(); it != results.constEnd(); ++it)
+        {
+            if (batchEntry->getStagedResult(it.key()) == it.value())
+            {
+                batchEntry->unstage(it.key());
+            }
+        }
+    }
+
+    // Refresh the UI once for the whole batch, unless the user has moved on
+    if (tournamentId == getCurrentTournamentId())
+    {
+        int currentTabIndex = roundTabs->currentIndex();
+
+        updateMatchTabs();
+        updateLeaderboard();
+
+        if (currentTabIndex >= 0 && currentTabIndex < roundTabs->count())
+        {
+            roundTabs->setCurrentIndex(currentTabIndex);
+        }
+    }
+
+    updateBatchStatus();
+    batchEntryEdit->setFocus();
+    mainStatusBar->showMessage(QString("%1 results committed").arg(committedCount));
+
+    // Boards locked from elsewhere since they were staged keep their result
+    if (!skipped.isEmpty())
+    {
+        QStringList ids;
+        for (int matchId : skipped)
+        {
+            ids.append(QString::number(matchId));
+        }
+        QMessageBox::warning(this, "Results Skipped",
+                             QString("%1 staged results were not committed because their matches were locked or "
+                                     "removed since they were staged (match IDs %2).")
+                                 .arg(skipped.size())
+                                 .arg(ids.join(", ")));
+    }
+}
+
+void MainWindow::onDiscardBatchClicked()
+{
+    if (batchEntry->isEmpty() || batchCommitPending)
+        return;
+
+    QMessageBox::StandardButton reply;
+    reply = QMessageBox::question(this, "Discard Staged Results",
+                                  QString("Discard %1 staged results?").arg(batchEntry->count()),
+                                  QMessageBox::Yes | QMessageBox::No);
+
+    if (reply == QMessageBox::Yes)
+    {
+        batchEntry->clear();
+        updateMatchTabs();
+        updateBatchStatus();
+        mainStatusBar->showMessage("Staged results discarded");
+    }
+}
+
+void MainWindow::restoreStagedResults()
+{
+    if (!batchEntry->loadJournal())
+        return;
+
+    QMessageBox::StandardButton reply;
+    reply = QMessageBox::question(this, "Recover Staged Results",
+                                  QString("%1 staged results from a previous session were recovered. Keep them for batch entry?").arg(batchEntry->count()),
+                                  QMessageBox::Yes | QMessageBox::No);
+
+    if (reply == QMessageBox::No)
+    {
+        batchEntry->clear();
+        updateBatchStatus();
+        return;
+    }
+
+    // Switch to the tournament the results were staged for
+    for (int i = 0; i < tournamentSelector->count(); ++i)
+    {
+        if (tournamentSelector->itemData(i).toInt() == batchEntry->getTournamentId())
+        {
+            tournamentSelector->setCurrentIndex(i);
+            break;
+        }
+    }
+
+    batchModeAction->setChecked(true);
+    updateMatchTabs();
+    updateBatchStatus();
+}
+
+void MainWindow::updateBatchStatus()
+{
+    batchStatusLabel->setText(QString("  %1 staged  ").arg(batchEntry->count()));
+    commitBatchButton->setEnabled(!batchEntry->isEmpty() && !batchCommitPending);
+    discardBatchButton->setEnabled(!batchEntry->isEmpty() && !batchCommitPending);
 }
 
 void MainWindow::onStartTournamentClicked()
@@ -378,169 +1010,49 @@ void MainWindow::onEndTournamentClicked()
     if (reply == QMessageBox::No)
         return;
 
+    // Ignore repeated requests while final standings are being calculated
+    if (standingsCalculator->isBusy(StandingsCalculator::FinalResults))
+        return;
+
     // Get current tournament ID
     int tournamentId = getCurrentTournamentId();
 
-    // Calculate final standings with tiebreakers
-    updateLeaderboard();
-
-    // Prepare tournament results data
-    QList<TournamentResult> results;
-    QList<Player> players = database->getAllPlayers();
-    QList<Match> matches = database->getAllMatches(tournamentId);
-
-    // Calculate player statistics
-    struct PlayerStats
-    {
-        int id;
-        QString name;
-        double points;
-        int wins;
-        int losses;
-        int draws;
-        double buchholzCutOne;
-        double sonnebornBerger;
-        int numberOfWins;
-        double cumulativeOpponentScore;
-    };
-
-    QList<PlayerStats> playerStats;
-    for (const Player &player : players)
-    {
-        PlayerStats stats;
-        stats.id = player.getId();
-        stats.name = player.getName();
-        stats.points = 0.0;
-        stats.wins = 0;
-        stats.losses = 0;
-        stats.draws = 0;
-
-        // Calculate basic statistics
-        for (const Match &match : matches)
-        {
-            if (match.isPlayed())
-            {
-                if (match.getPlayer1Id() == player.getId())
-                {
-                    if (match.getResult() == "p1")
-                    {
-                        stats.wins++;
-                        stats.points += 1.0;
-                    }
-                    else if (match.getResult() == "p2")
-                    {
-                        stats.losses++;
-                    }
-                    else if (match.getResult() == "draw")
-                    {
-                        stats.draws++;
-                        stats.points += 0.5;
-                    }
-                }
-                else if (match.getPlayer2Id() == player.getId())
-                {
-                    if (match.getResult() == "p2")
-                    {
-                        stats.wins++;
-                        stats.points += 1.0;
-                    }
-                    else if (match.getResult() == "p1")
-                    {
-                        stats.losses++;
-                    }
-                    else if (match.getResult() == "draw")
-                    {
-                        stats.draws++;
-                        stats.points += 0.5;
-                    }
-                }
-            }
-        }
-
-        // Calculate tiebreaker scores
-        stats.buchholzCutOne = Tiebreaker::calculateBuchholzCutOne(player, players, matches);
-        stats.sonnebornBerger = Tiebreaker::calculateSonnebornBerger(player, players, matches);
-        stats.numberOfWins = Tiebreaker::calculateNumberOfWins(player, matches);
-        stats.cumulativeOpponentScore = Tiebreaker::calculateCumulativeOpponentScore(player, players, matches);
+    // Calculate final standings with tiebreakers on a worker thread,
+    // finishTournament() takes over once they are ready
+    endTournamentButton->setEnabled(false);
+    standingsCalculator->request(createStandingsSnapshot(tournamentId, true), StandingsCalculator::FinalResults);
 
-        playerStats.append(stats);
-    }
+    mainStatusBar->showMessage("Calculating final standings...");
+}
 
-    // Sort by points (descending), then by tiebreakers
-    std::sort(playerStats.begin(), playerStats.end(), [this](const PlayerStats &a, const PlayerStats &b)
-              {
-        if (a.points != b.points) {
-            return a.points > b.points;
-        }
-        
-        // Apply tiebreaker based on settings
-        if (settings->getUseSeriesTiebreakers()) {
-            // Use series of tiebreakers
-            QList<int> tiebreakers = settings->getSeriesTiebreakers();
-            for (int tiebreakerType : tiebreakers) {
-                switch (tiebreakerType) {
-                    case Tiebreaker::BuchholzCutOne:
-                        if (a.buchholzCutOne != b.buchholzCutOne) {
-                            return a.buchholzCutOne > b.buchholzCutOne;
-                        }
-                        break;
-                    case Tiebreaker::SonnebornBerger:
-                        if (a.sonnebornBerger != b.sonnebornBerger) {
-                            return a.sonnebornBerger > b.sonnebornBerger;
-                        }
-                        break;
-                    case Tiebreaker::NumberOfWins:
-                        if (a.numberOfWins != b.numberOfWins) {
-                            return a.numberOfWins > b.numberOfWins;
-                        }
-                        break;
-                    case Tiebreaker::CumulativeOpponentScore:
-                        if (a.cumulativeOpponentScore != b.cumulativeOpponentScore) {
-                            return a.cumulativeOpponentScore > b.cumulativeOpponentScore;
-                        }
-                        break;
-                }
-            }
-        } else {
-            // Use single tiebreaker
-            int tiebreakerType = settings->getSingleTiebreaker();
-            switch (tiebreakerType) {
-                case Tiebreaker::BuchholzCutOne:
-                    return a.buchholzCutOne > b.buchholzCutOne;
-                case Tiebreaker::SonnebornBerger:
-                    return a.sonnebornBerger > b.sonnebornBerger;
-                case Tiebreaker::NumberOfWins:
-                    return a.numberOfWins > b.numberOfWins;
-                case Tiebreaker::CumulativeOpponentScore:
-                    return a.cumulativeOpponentScore > b.cumulativeOpponentScore;
-            }
-        }
-        
-        // If still tied, sort by name
-        return a.name < b.name; });
+void MainWindow::finishTournament(const StandingsResult &result)
+{
+    int tournamentId = result.tournamentId;
 
     // Convert to TournamentResult objects
-    for (int i = 0; i < playerStats.size(); ++i)
-    {
-        const PlayerStats &stats = playerStats[i];
-        TournamentResult result;
-        result.playerId = stats.id;
-        result.playerName = stats.name;
-        result.finalRank = i + 1;
-        result.points = stats.points;
-        result.wins = stats.wins;
-        result.losses = stats.losses;
-        result.draws = stats.draws;
-        result.buchholzCutOne = stats.buchholzCutOne;
-        result.sonnebornBerger = stats.sonnebornBerger;
-        result.numberOfWins = stats.numberOfWins;
-        result.cumulativeOpponentScore = stats.cumulativeOpponentScore;
-        results.append(result);
+    QList<TournamentResult> results;
+    for (int i = 0; i < result.standings.size(); ++i)
+    {
+        const PlayerStanding &stats = result.standings[i];
+        TournamentResult tournamentResult;
+        tournamentResult.playerId = stats.playerId;
+        tournamentResult.playerName = stats.playerName;
+        tournamentResult.finalRank = i + 1;
+        tournamentResult.points = stats.points;
+        tournamentResult.wins = stats.wins;
+        tournamentResult.losses = stats.losses;
+        tournamentResult.draws = stats.draws;
+        tournamentResult.buchholzCutOne = stats.buchholzCutOne;
+        tournamentResult.sonnebornBerger = stats.sonnebornBerger;
+        tournamentResult.numberOfWins = stats.numberOfWins;
+        tournamentResult.cumulativeOpponentScore = stats.cumulativeOpponentScore;
+        results.append(tournamentResult);
     }
 
     // Save tournament results to permanent table
     if (!database->saveTournamentResults(tournamentId, results))
     {
+        endTournamentButton->setEnabled(true);
         QMessageBox::critical(this, "Error", "Failed to save tournament results.");
         return;
     }
@@ -552,10 +1064,14 @@ void MainWindow::onEndTournamentClicked()
 
     if (!database->updateTournament(tournament))
     {
+        endTournamentButton->setEnabled(true);
         QMessageBox::critical(this, "Error", "Failed to update tournament status.");
         return;
     }
 
+    // Refresh the leaderboard with the final results
+    updateLeaderboard();
+
     // Show final results
     QMessageBox::information(this, "Tournament Completed",
                              "The tournament has been completed successfully.\n\n"
@@ -563,6 +1079,7 @@ void MainWindow::onEndTournamentClicked()
                              "You can now export the results or start a new tournament.");
 
     // Offer to export results
+    QMessageBox::StandardButton reply;
     reply = QMessageBox::question(this, "Export Results",
                                   "Would you like to export the tournament results to a CSV file?",
                                   QMessageBox::Yes | QMessageBox::No);
@@ -593,127 +1110,103 @@ void MainWindow::onEndTournamentClicked()
 
 void MainWindow::calculateAndDisplayTiebreakers()
 {
-    // Get players and matches for current tournament
-    QList<Player> players = database->getAllPlayers();
+    // Recompute the leaderboard with tiebreakers applied; the table is
+    // updated from onStandingsReady() once the worker is done
     int tournamentId = getCurrentTournamentId();
-    QList<Match> matches = database->getAllMatches(tournamentId);
+    standingsCalculator->request(createStandingsSnapshot(tournamentId, true), StandingsCalculator::Leaderboard);
+
+    mainStatusBar->showMessage("Calculating tiebreakers...");
+}
+
+StandingsSnapshot MainWindow::createStandingsSnapshot(int tournamentId, bool computeTiebreakers)
+{
+    // Players and matches are read by the worker through the read pool
+    StandingsSnapshot snapshot = createStandingsSnapshot(tournamentId, QList<Player>(), QList<Match>(), computeTiebreakers);
+    snapshot.loadFromDatabase = true;
+    return snapshot;
+}
+
+StandingsSnapshot MainWindow::createStandingsSnapshot(int tournamentId, const QList<Player> &players,
+                                                      const QList<Match> &matches, bool computeTiebreakers)
+{
+    StandingsSnapshot snapshot;
+    snapshot.tournamentId = tournamentId;
+    snapshot.players = players;
+    snapshot.matches = matches;
+    snapshot.computeTiebreakers = computeTiebreakers;
+    snapshot.useSeriesTiebreakers = settings->getUseSeriesTiebreakers();
+    snapshot.singleTiebreaker = settings->getSingleTiebreaker();
+    snapshot.seriesTiebreakers = settings->getSeriesTiebreakers();
+    return snapshot;
+}
 
-    // Calculate tiebreaker scores for each player
-    struct PlayerTiebreakerStats
+void MainWindow::onStandingsReady(const StandingsResult &result, StandingsCalculator::Purpose purpose)
+{
+    OT_TRACE_SCOPE("MainWindow::onStandingsReady");
+    if (purpose == StandingsCalculator::FinalResults)
     {
-        int id;
-        QString name;
-        double points;
-        double buchholzCutOne;
-        double sonnebornBerger;
-        int numberOfWins;
-        double cumulativeOpponentScore;
-    };
+        finishTournament(result);
+        return;
+    }
 
-    QList<PlayerTiebreakerStats> playerStats;
-    for (const Player &player : players)
+    // Ignore standings for a tournament that is no longer selected
+    lastStandingsMs = result.computeMs;
+    if (result.tournamentId != getCurrentTournamentId())
     {
-        PlayerTiebreakerStats stats;
-        stats.id = player.getId();
-        stats.name = player.getName();
+        finishRefreshMeasurement();
+        return;
+    }
 
-        // Calculate basic points
-        stats.points = 0.0;
-        for (const Match &match : matches)
-        {
-            if (match.isPlayed())
-            {
-                if (match.getPlayer1Id() == player.getId())
-                {
-                    if (match.getResult() == "p1")
-                        stats.points += 1.0;
-                    else if (match.getResult() == "draw")
-                        stats.points += 0.5;
-                }
-                else if (match.getPlayer2Id() == player.getId())
-                {
-                    if (match.getResult() == "p2")
-                        stats.points += 1.0;
-                    else if (match.getResult() == "draw")
-                        stats.points += 0.5;
-                }
-            }
-        }
+    displayStandings(result.standings);
+    playerIndex = result.playerIndex;
+    finishRefreshMeasurement();
 
-        // Calculate tiebreaker scores
-        stats.buchholzCutOne = Tiebreaker::calculateBuchholzCutOne(player, players, matches);
-        stats.sonnebornBerger = Tiebreaker::calculateSonnebornBerger(player, players, matches);
-        stats.numberOfWins = Tiebreaker::calculateNumberOfWins(player, matches);
-        stats.cumulativeOpponentScore = Tiebreaker::calculateCumulativeOpponentScore(player, players, matches);
+    // Show/hide tiebreaker button
+    if (tiebreakerButton)
+    {
+        tiebreakerButton->setVisible(Standings::hasTies(result.standings));
+    }
 
-        playerStats.append(stats);
+    if (result.tiebreakersApplied)
+    {
+        mainStatusBar->showMessage("Tiebreakers calculated and applied");
     }
+}
 
-    // Sort by points (descending), then by selected tiebreaker(s)
-    std::sort(playerStats.begin(), playerStats.end(), [this](const PlayerTiebreakerStats &a, const PlayerTiebreakerStats &b)
-              {
-        if (a.points != b.points) {
-            return a.points > b.points;
-        }
-        
-        // Apply tiebreaker based on settings
-        if (settings->getUseSeriesTiebreakers()) {
-            // Use series of tiebreakers
-            QList<int> tiebreakers = settings->getSeriesTiebreakers();
-            for (int tiebreakerType : tiebreakers) {
-                switch (tiebreakerType) {
-                    case Tiebreaker::BuchholzCutOne:
-                        if (a.buchholzCutOne != b.buchholzCutOne) {
-                            return a.buchholzCutOne > b.buchholzCutOne;
-                        }
-                        break;
-                    case Tiebreaker::SonnebornBerger:
-                        if (a.sonnebornBerger != b.sonnebornBerger) {
-                            return a.sonnebornBerger > b.sonnebornBerger;
-                        }
-                        break;
-                    case Tiebreaker::NumberOfWins:
-                        if (a.numberOfWins != b.numberOfWins) {
-                            return a.numberOfWins > b.numberOfWins;
-                        }
-                        break;
-                    case Tiebreaker::CumulativeOpponentScore:
-                        if (a.cumulativeOpponentScore != b.cumulativeOpponentScore) {
-                            return a.cumulativeOpponentScore > b.cumulativeOpponentScore;
-                        }
-                        break;
-                }
-            }
-        } else {
-            // Use single tiebreaker
-            int tiebreakerType = settings->getSingleTiebreaker();
-            switch (tiebreakerType) {
-                case Tiebreaker::BuchholzCutOne:
-                    return a.buchholzCutOne > b.buchholzCutOne;
-                case Tiebreaker::SonnebornBerger:
-                    return a.sonnebornBerger > b.sonnebornBerger;
-                case Tiebreaker::NumberOfWins:
-                    return a.numberOfWins > b.numberOfWins;
-                case Tiebreaker::CumulativeOpponentScore:
-                    return a.cumulativeOpponentScore > b.cumulativeOpponentScore;
-            }
-        }
-        
-        // If still tied, sort by name
-        return a.name < b.name; });
+void MainWindow::onStandingsFailed(int tournamentId, StandingsCalculator::Purpose purpose)
+{
+    Q_UNUSED(tournamentId);
+    if (purpose == StandingsCalculator::FinalResults)
+    {
+        endTournamentButton->setEnabled(true);
+        mainStatusBar->clearMessage();
+        QMessageBox::critical(this, "Error", "Failed to calculate final standings. The tournament is still active.");
+        return;
+    }
+
+    // The measurement of this refresh ends here, so the next one can start
+    finishRefreshMeasurement();
+    mainStatusBar->showMessage("Failed to load standings; they are updated with the next refresh");
+}
 
-    // Update player table with tiebreaker-adjusted rankings
-    playerTable->setRowCount(playerStats.size());
-    for (int i = 0; i < playerStats.size(); ++i)
+void MainWindow::displayStandings(const QList<PlayerStanding> &standings)
+{
+    OT_TRACE_SCOPE("MainWindow::displayStandings");
+    // Update player table
+    standingsRowByPlayer.clear();
+    playerTable->setRowCount(standings.size());
+    cellsRebuilt += standings.size() * playerTable->columnCount();
+    for (int i = 0; i < standings.size(); ++i)
     {
-        const PlayerTiebreakerStats &stats = playerStats[i];
+        const PlayerStanding &stats = standings[i];
+        standingsRowByPlayer.insert(stats.playerId, i);
 
         QTableWidgetItem *rankItem = new QTableWidgetItem(QString::number(i + 1));
-        QTableWidgetItem *nameItem = new QTableWidgetItem(stats.name);
+        QTableWidgetItem *nameItem = new QTableWidgetItem(stats.playerName);
         QTableWidgetItem *pointsItem = new QTableWidgetItem(QString::number(stats.points, 'f', 1));
 
         // Store player ID in the rank item's data
-        rankItem->setData(Qt::UserRole, stats.id);
+        rankItem->setData(Qt::UserRole, stats.playerId);
 
         // Center-align the points column
         pointsItem->setTextAlignment(Qt::AlignCenter);
@@ -722,8 +1215,6 @@ void MainWindow::calculateAndDisplayTiebreakers()
         playerTable->setItem(i, 1, nameItem);
         playerTable->setItem(i, 2, pointsItem);
     }
-
-    mainStatusBar->showMessage("Tiebreakers calculated and applied");
 }
 
 void MainWindow::showTiebreakerSettingsDialog()
@@ -905,6 +1396,66 @@ void MainWindow::onDeletePlayer()
     }
 }
 
+void MainWindow::onPlayerSearchTextChanged(const QString &text)
+{
+    // Look up the prefix index built with the latest standings snapshot
+    searchResults = playerIndex.find(text);
+    searchResultPosition = 0;
+
+    if (searchResults.isEmpty())
+    {
+        if (!text.trimmed().isEmpty())
+        {
+            mainStatusBar->showMessage(QString("No player matches \"%1\"").arg(text.trimmed()));
+        }
+        return;
+    }
+
+    jumpToPlayer(searchResults.first());
+}
+
+void MainWindow::onPlayerSearchNext()
+{
+    if (searchResults.isEmpty())
+        return;
+
+    // Enter cycles through the matching players
+    searchResultPosition = (searchResultPosition + 1) % searchResults.size();
+    jumpToPlayer(searchResults[searchResultPosition]);
+}
+
+void MainWindow::jumpToPlayer(int playerId)
+{
+    // Select the player's standings row
+    int standingsRow = standingsRowByPlayer.value(playerId, -1);
+    if (standingsRow >= 0)
+    {
+        playerTable->selectRow(standingsRow);
+        playerTable->scrollToItem(playerTable->item(standingsRow, 0));
+    }
+
+    // Select the player's match in the current round
+    int matchRow = currentRoundRowByPlayer.value(playerId, -1);
+    QTableWidget *roundTable = qobject_cast<QTableWidget *>(roundTabs->widget(currentRoundTabIndex));
+    if (matchRow >= 0 && roundTable)
+    {
+        roundTabs->setCurrentIndex(currentRoundTabIndex);
+        roundTable->selectRow(matchRow);
+        roundTable->scrollToItem(roundTable->item(matchRow, 0));
+        mainStatusBar->showMessage(QString("Board %1 in %2 (%3 of %4 results)")
+                                       .arg(matchRow + 1)
+                                       .arg(roundTabs->tabText(currentRoundTabIndex))
+                                       .arg(searchResultPosition + 1)
+                                       .arg(searchResults.size()));
+    }
+    else if (standingsRow >= 0)
+    {
+        mainStatusBar->showMessage(QString("Player has no match in the current round (%1 of %2 results)")
+                                       .arg(searchResultPosition + 1)
+                                       .arg(searchResults.size()));
+    }
+}
+
 void MainWindow::setupMatchPanel()
 {
     roundTabs = new QTabWidget(this);
@@ -918,12 +1469,47 @@ void MainWindow::onAddPlayerClicked()
 
 void MainWindow::showAddPlayerDialog()
 {
-    bool ok;
-    QString name = QInputDialog::getText(this, "Add Player",
-                                         "Enter player name:", QLineEdit::Normal,
-                                         "", &ok);
+    QDialog addPlayerDialog(this);
+    addPlayerDialog.setWindowTitle("Add Player");
+    QVBoxLayout *layout = new QVBoxLayout(&addPlayerDialog);
+    layout->addWidget(new QLabel("Enter player name:", &addPlayerDialog));
+
+    QLineEdit *nameEdit = new QLineEdit(&addPlayerDialog);
+    layout->addWidget(nameEdit);
+
+    // Suggest returning players from the registry as the name is typed.
+    // Suggestions are already ranked by the search, so the completer shows
+    // them unfiltered.
+    QStringListModel *suggestions = new QStringListModel(&addPlayerDialog);
+    QCompleter *completer = new QCompleter(suggestions, &addPlayerDialog);
+    completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    nameEdit->setCompleter(completer);
+    connect(nameEdit, &QLineEdit::textEdited, &addPlayerDialog, [this, suggestions, completer](const QString &text)
+            {
+        QStringList names;
+        for (const Player &player : database->searchPlayers(text))
+        {
+            names.append(player.getName());
+        }
+        suggestions->setStringList(names);
+        if (!names.isEmpty())
+        {
+            completer->complete();
+        } });
 
-    if (ok && !name.isEmpty())
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel,
+                                                       Qt::Horizontal, &addPlayerDialog);
+    layout->addWidget(buttonBox);
+    connect(buttonBox, &QDialogButtonBox::accepted, &addPlayerDialog, &QDialog::accept);
+    connect(buttonBox, &QDialogButtonBox::rejected, &addPlayerDialog, &QDialog::reject);
+
+    if (addPlayerDialog.exec() != QDialog::Accepted)
+    {
+        return;
+    }
+
+    QString name = nameEdit->text().trimmed();
+    if (!name.isEmpty())
     {
         // Check if player already exists in the current tournament
         int tournamentId = getCurrentTournamentId();
@@ -952,6 +1538,71 @@ void MainWindow::showAddPlayerDialog()
     }
 }
 
+void MainWindow::onImportRosterClicked()
+{
+    // Rosters follow the same rule as single players
+    if (!addPlayerButton->isEnabled())
+    {
+        QMessageBox::warning(this, "Import Roster", "Players cannot be added to this tournament anymore.");
+        return;
+    }
+
+    QString fileName = QFileDialog::getOpenFileName(this,
+                                                    "Import Roster",
+                                                    QString(),
+                                                    "Roster Files (*.csv *.tsv *.txt);;All Files (*)");
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QMessageBox::critical(this, "Error", "Failed to open roster file.");
+        return;
+    }
+
+    // The whole file is entered in one transaction, so a failure adds nobody
+    QTextStream in(&file);
+    RosterImporter importer(in);
+    RosterImportResult result = database->importRoster(getCurrentTournamentId(), [&importer](RosterEntry &entry)
+                                                       { return importer.next(entry); });
+    if (!result.ok)
+    {
+        QMessageBox::critical(this, "Error", "Failed to import roster.");
+        return;
+    }
+
+    updatePlayerList();
+    updateMatchTabs();
+
+    QString summary = QString("%1 players imported (%2 new, %3 returning)")
+                          .arg(result.added + result.returning)
+                          .arg(result.added)
+                          .arg(result.returning);
+    mainStatusBar->showMessage(summary);
+
+    // List skipped names in the details, since a roster can hold thousands
+    if (!result.duplicates.isEmpty() || !result.alreadyRegistered.isEmpty())
+    {
+        QStringList details;
+        for (const QString &name : result.duplicates)
+        {
+            details.append("Listed more than once: " + name);
+        }
+        for (const QString &name : result.alreadyRegistered)
+        {
+            details.append("Already in the tournament: " + name);
+        }
+
+        QMessageBox box(QMessageBox::Information, "Import Roster", summary + ".", QMessageBox::Ok, this);
+        box.setInformativeText(QString("%1 names were skipped.").arg(details.size()));
+        box.setDetailedText(details.join('\n'));
+        box.exec();
+    }
+}
+
 void MainWindow::onResetTournamentClicked()
 {
     // Create a dialog with options
@@ -1043,63 +1694,100 @@ void MainWindow::onExportResultsClicked()
     }
 }
 
-void MainWindow::exportToCSV(const QString &filename)
+void MainWindow::onBackupNowClicked()
+{
+    // The backup runs on its own thread; result entry continues meanwhile
+    mainStatusBar->showMessage("Backing up database...");
+    backupManager->backupNow().then(this, [this](const QString &path)
+                                    {
+        if (path.isEmpty())
+        {
+            mainStatusBar->clearMessage();
+            QMessageBox::critical(this, "Error", "Failed to back up the database.");
+            return;
+        }
+
+        mainStatusBar->showMessage("Database backed up to " + path); });
+}
+
+void MainWindow::onRestoreBackupClicked()
 {
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    if (batchCommitPending)
     {
-        QMessageBox::critical(this, "Error", "Failed to create export file.");
+        mainStatusBar->showMessage("Wait for the batch commit to finish before restoring a backup");
         return;
     }
 
-    QTextStream out(&file);
+    QString fileName = QFileDialog::getOpenFileName(this, "Restore Backup", backupManager->getBackupDirectory(),
+                                                    "Backups (tournament-*.db);;Database Files (*.db)");
+    if (fileName.isEmpty())
+        return;
+
+    QMessageBox::StandardButton reply;
+    reply = QMessageBox::question(this, "Confirm Restore",
+                                  QString("Replace the current database with the backup '%1'? Every change made since it was taken will be lost.")
+                                      .arg(QFileInfo(fileName).fileName()),
+                                  QMessageBox::Yes | QMessageBox::No);
+    if (reply != QMessageBox::Yes)
+        return;
 
-    // Write header
-    out << "Player,Points,Wins,Losses,Draws\n";
+    // Results still queued on the worker would land on the restored data
+    asyncDatabase->write([](Database &)
+                         { return true; })
+        .waitForFinished();
 
-    // Get player statistics for current tournament
-    int tournamentId = getCurrentTournamentId();
-    QList<Player> players = database->getAllPlayers();
-    QList<Player> tournamentPlayers = database->getPlayersForTournament(tournamentId);
-    QList<Match> matches = database->getAllMatches(tournamentId);
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    bool ok = BackupManager::restore(fileName, *database) && database->initializeSchema();
+    QApplication::restoreOverrideCursor();
 
-    for (const Player &player : tournamentPlayers)
+    if (!ok)
     {
-        int wins = 0, losses = 0, draws = 0;
+        QMessageBox::critical(this, "Error",
+                              "Failed to restore the backup. Close the application and restore it by hand as described in the README.");
+        return;
+    }
 
-        for (const Match &match : matches)
+    populateTournamentSelector();
+    if (tournamentSelector->count() > 0)
+    {
+        onTournamentSelectionChanged(0);
+    }
+
+    mainStatusBar->showMessage("Database restored from " + fileName);
+}
+
+void MainWindow::exportToCSV(const QString &filename)
+{
+    OT_TRACE_SCOPE("MainWindow::exportToCSV");
+
+    // Read and write on a worker with a read-only connection, so large
+    // exports do not block the window or queued result writes
+    int tournamentId = getCurrentTournamentId();
+    mainStatusBar->showMessage("Exporting results...");
+
+    QtConcurrent::run([pool = readPool, tournamentId, filename]()
+                      {
+        Database *connection = pool->connection();
+        QFile file(filename);
+        if (!connection || !file.open(QIODevice::WriteOnly | QIODevice::Text))
         {
-            if (match.isPlayed())
-            {
-                if (match.getPlayer1Id() == player.getId())
-                {
-                    if (match.getResult() == "p1")
-                        wins++;
-                    else if (match.getResult() == "p2")
-                        losses++;
-                    else if (match.getResult() == "draw")
-                        draws++;
-                }
-                else if (match.getPlayer2Id() == player.getId())
-                {
-                    if (match.getResult() == "p2")
-                        wins++;
-                    else if (match.getResult() == "p1")
-                        losses++;
-                    else if (match.getResult() == "draw")
-                        draws++;
-                }
-            }
+            return false;
         }
 
-        double points = wins + (draws * 0.5);
-        out << "\"" << player.getName() << "\","
-            << QString::number(points, 'f', 1) << ","
-            << wins << "," << losses << "," << draws << "\n";
-    }
+        // The export has no tiebreaker columns, so the stored standings do
+        QTextStream out(&file);
+        Standings::writeCsv(out, connection->getStandings(tournamentId));
+        return true; })
+        .then(this, [this, filename](bool ok)
+              {
+        if (!ok)
+        {
+            mainStatusBar->clearMessage();
+            QMessageBox::critical(this, "Error", "Failed to create export file.");
+            return;
+        }
 
-    file.close();
-    mainStatusBar->showMessage("Results exported successfully to " + filename);
+        mainStatusBar->showMessage("Results exported successfully to " + filename); });
 }
 
 void MainWindow::onMatchResultClicked()
@@ -1120,29 +1808,38 @@ void MainWindow::onMatchResultClicked()
 
     if (reply == QMessageBox::Yes)
     {
-        if (database->updateMatchResult(matchId, result))
-        {
-            if (database->lockMatch(matchId))
-            {
-                // Store the current tab index before updating tabs
-                int currentTabIndex = roundTabs->currentIndex();
+        // Save and lock the result on the database thread; submissions made
+        // in quick succession are committed together
+        button->setEnabled(false);
+        mainStatusBar->showMessage("Submitting result...");
 
+        int tournamentId = getCurrentTournamentId();
+        asyncDatabase->submitResult(tournamentId, matchId, result).then(this, [this, tournamentId](bool ok)
+                                                                           {
+            if (!ok)
+            {
+                QMessageBox::critical(this, "Error", "Failed to submit result.");
                 updateMatchTabs();
-                updateLeaderboard();
+                return;
+            }
 
-                // Restore the tab index after updating tabs
-                if (currentTabIndex >= 0 && currentTabIndex < roundTabs->count())
-                {
-                    roundTabs->setCurrentIndex(currentTabIndex);
-                }
+            // The user may have switched tournaments while the write was queued
+            if (tournamentId != getCurrentTournamentId())
+                return;
+
+            // Store the current tab index before updating tabs
+            int currentTabIndex = roundTabs->currentIndex();
+
+            updateMatchTabs();
+            updateLeaderboard();
 
-                mainStatusBar->showMessage("Result submitted successfully");
+            // Restore the tab index after updating tabs
+            if (currentTabIndex >= 0 && currentTabIndex < roundTabs->count())
+            {
+                roundTabs->setCurrentIndex(currentTabIndex);
             }
-        }
-        else
-        {
-            QMessageBox::critical(this, "Error", "Failed to submit result.");
-        }
+
+            mainStatusBar->showMessage("Result submitted successfully"); });
     }
 }
 
@@ -1163,7 +1860,7 @@ void MainWindow::onEditMatchClicked()
 
     if (reply == QMessageBox::Yes)
     {
-        if (database->unlockMatch(matchId))
+        if (database->unlockMatch(getCurrentTournamentId(), matchId))
         {
             updateMatchTabs();
             mainStatusBar->showMessage("Match unlocked for editing");
@@ -1182,482 +1879,76 @@ void MainWindow::onPlayerSelectionChanged()
 
 void MainWindow::updatePlayerList()
 {
-    int tournamentId = getCurrentTournamentId();
-    QList<Player> players = database->getPlayersForTournament(tournamentId);
-    QList<Match> matches = database->getAllMatches(tournamentId);
-
-    // Calculate points for each player
-    struct PlayerStats
-    {
-        int id;
-        QString name;
-        double points;
-        int wins;
-        int losses;
-        int draws;
-        // Tiebreaker scores
-        double buchholzCutOne;
-        double sonnebornBerger;
-        int numberOfWins;
-        double cumulativeOpponentScore;
-    };
-
-    QList<PlayerStats> playerStats;
-    for (const Player &player : players)
-    {
-        PlayerStats stats;
-        stats.id = player.getId();
-        stats.name = player.getName();
-        stats.points = 0.0;
-        stats.wins = 0;
-        stats.losses = 0;
-        stats.draws = 0;
-        // Initialize tiebreaker scores
-        stats.buchholzCutOne = 0.0;
-        stats.sonnebornBerger = 0.0;
-        stats.numberOfWins = 0;
-        stats.cumulativeOpponentScore = 0.0;
-
-        for (const Match &match : matches)
-        {
-            if (match.isPlayed())
-            {
-                if (match.getPlayer1Id() == player.getId())
-                {
-                    if (match.getResult() == "p1")
-                    {
-                        stats.wins++;
-                        stats.points += 1.0;
-                    }
-                    else if (match.getResult() == "p2")
-                    {
-                        stats.losses++;
-                    }
-                    else if (match.getResult() == "draw")
-                    {
-                        stats.draws++;
-                        stats.points += 0.5;
-                    }
-                }
-                else if (match.getPlayer2Id() == player.getId())
-                {
-                    if (match.getResult() == "p2")
-                    {
-                        stats.wins++;
-                        stats.points += 1.0;
-                    }
-                    else if (match.getResult() == "p1")
-                    {
-                        stats.losses++;
-                    }
-                    else if (match.getResult() == "draw")
-                    {
-                        stats.draws++;
-                        stats.points += 0.5;
-                    }
-                }
-            }
-        }
-
-        // Calculate tiebreaker scores if there are ties
-        // For now, we'll just set them to the player's points
-        stats.buchholzCutOne = stats.points;
-        stats.sonnebornBerger = stats.points;
-        stats.numberOfWins = stats.wins;
-        stats.cumulativeOpponentScore = stats.points;
-
-        playerStats.append(stats);
-    }
-
-    // Sort by points (descending) then by name (ascending)
-    std::sort(playerStats.begin(), playerStats.end(), [](const PlayerStats &a, const PlayerStats &b)
-              {
-        if (a.points != b.points) {
-            return a.points > b.points;
-        }
-        return a.name < b.name; });
-
-    // Update player table
-    playerTable->setRowCount(playerStats.size());
-    for (int i = 0; i < playerStats.size(); ++i)
-    {
-        const PlayerStats &stats = playerStats[i];
-
-        QTableWidgetItem *rankItem = new QTableWidgetItem(QString::number(i + 1));
-        QTableWidgetItem *nameItem = new QTableWidgetItem(stats.name);
-        QTableWidgetItem *pointsItem = new QTableWidgetItem(QString::number(stats.points, 'f', 1));
-
-        // Store player ID in the rank item's data
-        rankItem->setData(Qt::UserRole, stats.id);
+    OT_TRACE_SCOPE("MainWindow::updatePlayerList");
+    beginRefreshMeasurement();
 
-        // Center-align the points column
-        pointsItem->setTextAlignment(Qt::AlignCenter);
-
-        playerTable->setItem(i, 0, rankItem);
-        playerTable->setItem(i, 1, nameItem);
-        playerTable->setItem(i, 2, pointsItem);
-    }
+    // Standings are computed on a worker thread and shown by onStandingsReady()
+    int tournamentId = getCurrentTournamentId();
+    standingsCalculator->request(createStandingsSnapshot(tournamentId, false), StandingsCalculator::Leaderboard);
 }
 
 void MainWindow::updateLeaderboard()
 {
+    OT_TRACE_SCOPE("MainWindow::updateLeaderboard");
+    // The tiebreaker button is shown or hidden when the refreshed
+    // standings arrive, depending on whether any players are tied
     updatePlayerList();
-
-    // Check for ties and show/hide tiebreaker button
-    QList<Player> players = database->getAllPlayers();
-    int tournamentId = getCurrentTournamentId();
-    QList<Match> matches = database->getAllMatches(tournamentId);
-
-    // Calculate points for each player
-    struct PlayerStats
-    {
-        int id;
-        QString name;
-        double points;
-    };
-
-    QList<PlayerStats> playerStats;
-    for (const Player &player : players)
-    {
-        PlayerStats stats;
-        stats.id = player.getId();
-        stats.name = player.getName();
-        stats.points = 0.0;
-
-        for (const Match &match : matches)
-        {
-            if (match.isPlayed())
-            {
-                if (match.getPlayer1Id() == player.getId())
-                {
-                    if (match.getResult() == "p1")
-                    {
-                        stats.points += 1.0;
-                    }
-                    else if (match.getResult() == "draw")
-                    {
-                        stats.points += 0.5;
-                    }
-                }
-                else if (match.getPlayer2Id() == player.getId())
-                {
-                    if (match.getResult() == "p2")
-                    {
-                        stats.points += 1.0;
-                    }
-                    else if (match.getResult() == "draw")
-                    {
-                        stats.points += 0.5;
-                    }
-                }
-            }
-        }
-
-        playerStats.append(stats);
-    }
-
-    // Check if there are ties
-    bool hasTies = false;
-    for (int i = 0; i < playerStats.size() - 1; i++)
-    {
-        for (int j = i + 1; j < playerStats.size(); j++)
-        {
-            if (playerStats[i].points == playerStats[j].points)
-            {
-                hasTies = true;
-                break;
-            }
-        }
-        if (hasTies)
-            break;
-    }
-
-    // Show/hide tiebreaker button
-    if (tiebreakerButton)
-    {
-        tiebreakerButton->setVisible(hasTies);
-    }
-}
-
-// Swiss Pairing structures and functions
-struct SwissPlayer
-{
-    int id;
-    QString name;
-    double points;
-    int wins;
-    int losses;
-    int draws;
-    QList<int> opponents; // List of opponent IDs
-};
-
-struct SwissPair
-{
-    int p1Id;
-    int p2Id;
-    QString p1Name;
-    QString p2Name;
-};
-
-// Calculate player standings for Swiss pairing
-QList<SwissPlayer> calculateStandings(const QList<Player> &players, const QList<Match> &matches)
-{
-    QList<SwissPlayer> standings;
-
-    // Initialize players with zero stats
-    for (const Player &player : players)
-    {
-        SwissPlayer swissPlayer;
-        swissPlayer.id = player.getId();
-        swissPlayer.name = player.getName();
-        swissPlayer.points = 0.0;
-        swissPlayer.wins = 0;
-        swissPlayer.losses = 0;
-        swissPlayer.draws = 0;
-
-        // Calculate stats from matches
-        for (const Match &match : matches)
-        {
-            if (match.isPlayed())
-            {
-                if (match.getPlayer1Id() == player.getId())
-                {
-                    swissPlayer.opponents.append(match.getPlayer2Id());
-                    if (match.getResult() == "p1")
-                    {
-                        swissPlayer.wins++;
-                        swissPlayer.points += 1.0;
-                    }
-                    else if (match.getResult() == "p2")
-                    {
-                        swissPlayer.losses++;
-                    }
-                    else if (match.getResult() == "draw")
-                    {
-                        swissPlayer.draws++;
-                        swissPlayer.points += 0.5;
-                    }
-                }
-                else if (match.getPlayer2Id() == player.getId())
-                {
-                    swissPlayer.opponents.append(match.getPlayer1Id());
-                    if (match.getResult() == "p2")
-                    {
-                        swissPlayer.wins++;
-                        swissPlayer.points += 1.0;
-                    }
-                    else if (match.getResult() == "p1")
-                    {
-                        swissPlayer.losses++;
-                    }
-                    else if (match.getResult() == "draw")
-                    {
-                        swissPlayer.draws++;
-                        swissPlayer.points += 0.5;
-                    }
-                }
-            }
-        }
-
-        standings.append(swissPlayer);
-    }
-
-    // Sort by points (descending), then by name (ascending)
-    std::sort(standings.begin(), standings.end(), [](const SwissPlayer &a, const SwissPlayer &b)
-              {
-        if (a.points != b.points)
-        {
-            return a.points > b.points;
-        }
-        return a.name < b.name; });
-
-    return standings;
 }
 
-// Check if two players have already played against each other
-bool havePlayed(const SwissPlayer &p1, const SwissPlayer &p2)
+void MainWindow::generateRoundRobinPairings(const QList<Player> &players)
 {
-    return p1.opponents.contains(p2.id) || p2.opponents.contains(p1.id);
+    OT_TRACE_SCOPE("MainWindow::generateRoundRobinPairings");
+    int tournamentId = getCurrentTournamentId();
+    Pairing::createRoundRobinSchedule(*database, tournamentId, players);
 }
 
-// Generate Swiss pairings for one round
-QList<SwissPair> generateSwissRound(QList<SwissPlayer> &players)
+void MainWindow::generateSwissPairings(const QList<Player> &players)
 {
-    QList<SwissPair> pairs;
+    OT_TRACE_SCOPE("MainWindow::generateSwissPairings");
+    int tournamentId = getCurrentTournamentId();
 
-    // Pair players from top to bottom, avoiding rematches
-    for (int i = 0; i < players.size(); ++i)
+    // Ensure we don't exceed the maximum number of rounds
+    if (Pairing::createSwissRound(*database, tournamentId, players, settings->getSwissRounds()) == 0)
     {
-        // Skip if player is already paired
-        if (players[i].id == -1)
-            continue;
-
-        // Look for an opponent who hasn't played this player
-        for (int j = i + 1; j < players.size(); ++j)
-        {
-            // Skip if player is already paired
-            if (players[j].id == -1)
-                continue;
-
-            // Check if they've already played
-            if (!havePlayed(players[i], players[j]))
-            {
-                // Create pair
-                SwissPair pair;
-                pair.p1Id = players[i].id;
-                pair.p2Id = players[j].id;
-                pair.p1Name = players[i].name;
-                pair.p2Name = players[j].name;
-                pairs.append(pair);
-
-                // Mark players as paired
-                players[i].id = -1;
-                players[j].id = -1;
-                break;
-            }
-        }
+        mainStatusBar->showMessage(QString("Maximum number of Swiss rounds (%1) reached").arg(settings->getSwissRounds()));
     }
-
-    return pairs;
 }
 
-struct Pair
-{
-    std::string p1;
-    std::string p2;
-};
-
-std::vector<std::vector<Pair>> roundRobinPairings(std::vector<std::string> players)
+void MainWindow::updateMatchTabs()
 {
-    int n = players.size();
-    if (n % 2 == 1)
-    {
-        players.push_back("BYE");
-        n++;
-    }
-    std::vector<std::vector<Pair>> rounds;
-    for (int r = 0; r < n - 1; r++)
-    {
-        std::vector<Pair> round;
-        for (int i = 0; i < n / 2; i++)
-        {
-            std::string p1 = players[i];
-            std::string p2 = players[n - 1 - i];
-            if (p1 != "BYE" && p2 != "BYE")
-                round.push_back({p1, p2});
-        }
-        rounds.push_back(round);
-        // rotate
-        std::rotate(players.begin() + 1, players.end() - 1, players.end());
-    }
-    return rounds;
-}
+    OT_TRACE_SCOPE("MainWindow::updateMatchTabs");
+    beginRefreshMeasurement();
 
-void MainWindow::generateRoundRobinPairings(const QList<Player> &players)
-{
+    // Get all matches for the current tournament
     int tournamentId = getCurrentTournamentId();
     QList<Match> matches = database->getAllMatches(tournamentId);
+    Tournament tournament = database->getTournamentById(tournamentId);
 
-    // We need at least 3 players to generate pairings
-    if (players.size() < 3)
-    {
-        return;
-    }
-
-    // Convert player names to std::string
-    std::vector<std::string> playerNames;
-    for (const Player &player : players)
+    // Resolve player names once instead of querying them per match
+    QHash<int, QString> playerNames;
+    for (const Player &player : database->getPlayersForTournament(tournamentId))
     {
-        playerNames.push_back(player.getName().toStdString());
+        playerNames.insert(player.getId(), player.getName());
     }
 
-    // Generate pairings
-    std::vector<std::vector<Pair>> pairings = roundRobinPairings(playerNames);
-
-    // Clear existing matches for this tournament
-    database->deleteMatchesForTournament(tournamentId);
-
-    // Reset match ID sequence for this tournament to ensure match IDs start at 1
-    database->resetMatchIdSequence(tournamentId);
-
-    // Create matches in database
-    int roundNumber = 1;
-    for (const auto &round : pairings)
-    {
-        for (const auto &pair : round)
-        {
-            // Find player IDs by name
-            int p1Id = -1, p2Id = -1;
-            QString p1Name = QString::fromStdString(pair.p1);
-            QString p2Name = QString::fromStdString(pair.p2);
-
-            for (const Player &player : players)
-            {
-                if (player.getName() == p1Name)
-                {
-                    p1Id = player.getId();
-                }
-                if (player.getName() == p2Name)
-                {
-                    p2Id = player.getId();
-                }
-            }
+    buildMatchTabs(tournament, matches, playerNames);
 
-            // Create match if both players found
-            if (p1Id != -1 && p2Id != -1)
-            {
-                int tournamentId = getCurrentTournamentId();
-                database->addMatch(tournamentId, roundNumber, p1Id, p2Id);
-            }
-        }
-        roundNumber++;
-    }
+    // Report once the caller has had a chance to request standings as well
+    QTimer::singleShot(0, this, &MainWindow::finishRefreshMeasurement);
 }
 
-void MainWindow::generateSwissPairings(const QList<Player> &players)
+void MainWindow::buildMatchTabs(const Tournament &tournament, const QList<Match> &matches, const QHash<int, QString> &playerNames)
 {
-    int tournamentId = getCurrentTournamentId();
-    QList<Match> matches = database->getAllMatches(tournamentId);
-
-    // We need at least 3 players to generate pairings
-    if (players.size() < 3)
-    {
-        return;
-    }
-
-    // Calculate current standings
-    QList<SwissPlayer> standings = calculateStandings(players, matches);
-
-    // Determine the next round number (max existing round + 1)
-    int maxRound = 0;
-    for (const Match &match : matches)
-    {
-        if (match.getRound() > maxRound)
-        {
-            maxRound = match.getRound();
-        }
-    }
-    int currentRound = maxRound + 1;
-
-    // Ensure we don't exceed the maximum number of rounds
-    if (currentRound > settings->getSwissRounds())
-    {
-        mainStatusBar->showMessage(QString("Maximum number of Swiss rounds (%1) reached").arg(settings->getSwissRounds()));
-        return;
-    }
+    OT_TRACE_SCOPE("MainWindow::buildMatchTabs");
+    int tournamentId = tournament.getId();
 
-    // Generate pairings for current round
-    QList<SwissPair> pairs = generateSwissRound(standings);
-
-    // Add new matches to database (without deleting existing ones)
-    for (const SwissPair &pair : pairs)
+    // Look up names of players no longer registered in the tournament
+    auto nameOf = [this, &playerNames](int playerId)
     {
-        database->addMatch(tournamentId, currentRound, pair.p1Id, pair.p2Id);
-    }
-}
+        auto it = playerNames.constFind(playerId);
+        return it != playerNames.constEnd() ? it.value() : database->getPlayerById(playerId).getName();
+    };
 
-void MainWindow::updateMatchTabs()
-{
     // Clear existing tabs
     while (roundTabs->count() > 0)
     {
@@ -1666,10 +1957,6 @@ void MainWindow::updateMatchTabs()
         delete widget;
     }
 
-    // Get all matches for the current tournament grouped by round
-    int tournamentId = getCurrentTournamentId();
-    QList<Match> matches = database->getAllMatches(tournamentId);
-
     // Group matches by round
     QMap<int, QList<Match>> matchesByRound;
     for (const Match &match : matches)
@@ -1681,6 +1968,10 @@ void MainWindow::updateMatchTabs()
     QList<int> rounds = matchesByRound.keys();
     std::sort(rounds.begin(), rounds.end());
 
+    // Remember where each player sits in the current round for player search
+    currentRoundRowByPlayer.clear();
+    currentRoundTabIndex = -1;
+
     for (int round : rounds)
     {
         QList<Match> roundMatches = matchesByRound[round];
@@ -1701,45 +1992,52 @@ void MainWindow::updateMatchTabs()
         {
             const Match &match = roundMatches[i];
 
+            if (round == rounds.last())
+            {
+                currentRoundRowByPlayer.insert(match.getPlayer1Id(), i);
+                currentRoundRowByPlayer.insert(match.getPlayer2Id(), i);
+            }
+
             // Get player names
-            Player player1 = database->getPlayerById(match.getPlayer1Id());
-            Player player2 = database->getPlayerById(match.getPlayer2Id());
+            QString p1Name = nameOf(match.getPlayer1Id());
+            QString p2Name = nameOf(match.getPlayer2Id());
 
-            // Match ID
+            // Match ID, with the ID and lock state kept for batch entry
             QTableWidgetItem *idItem = new QTableWidgetItem(QString::number(match.getId()));
             idItem->setFlags(idItem->flags() & ~Qt::ItemIsEditable);
+            idItem->setData(Qt::UserRole, match.getId());
+            idItem->setData(Qt::UserRole + 1, match.isLocked());
             table->setItem(i, 0, idItem);
 
             // Player names
-            QTableWidgetItem *p1Item = new QTableWidgetItem(player1.getName());
+            QTableWidgetItem *p1Item = new QTableWidgetItem(p1Name);
             p1Item->setFlags(p1Item->flags() & ~Qt::ItemIsEditable);
             table->setItem(i, 1, p1Item);
 
-            QTableWidgetItem *p2Item = new QTableWidgetItem(player2.getName());
+            QTableWidgetItem *p2Item = new QTableWidgetItem(p2Name);
             p2Item->setFlags(p2Item->flags() & ~Qt::ItemIsEditable);
             table->setItem(i, 2, p2Item);
 
-            // Result
+            // Result, or the staged result during batch entry
+            bool staged = batchEntry->getTournamentId() == tournamentId && batchEntry->isStaged(match.getId());
             QString resultText;
-            if (!match.isPlayed())
-            {
-                resultText = "Not Played";
-            }
-            else if (match.getResult() == "p1")
-            {
-                resultText = player1.getName() + " Wins";
-            }
-            else if (match.getResult() == "p2")
+            if (staged)
             {
-                resultText = player2.getName() + " Wins";
+                resultText = "Staged: " + describeResult(batchEntry->getStagedResult(match.getId()), p1Name, p2Name);
             }
-            else if (match.getResult() == "draw")
+            else
             {
-                resultText = "Draw";
+                resultText = describeResult(match.getResult(), p1Name, p2Name);
             }
 
             QTableWidgetItem *resultItem = new QTableWidgetItem(resultText);
             resultItem->setFlags(resultItem->flags() & ~Qt::ItemIsEditable);
+            if (staged)
+            {
+                QFont font = resultItem->font();
+                font.setItalic(true);
+                resultItem->setFont(font);
+            }
             table->setItem(i, 3, resultItem);
 
             // Actions
@@ -1785,11 +2083,15 @@ void MainWindow::updateMatchTabs()
         }
 
         // Add tab
-        roundTabs->addTab(table, QString("Round %1").arg(round));
+        cellsRebuilt += table->rowCount() * table->columnCount();
+        int tabIndex = roundTabs->addTab(table, QString("Round %1").arg(round));
+        if (round == rounds.last())
+        {
+            currentRoundTabIndex = tabIndex;
+        }
     }
 
     // Add "+" button for Swiss tournaments if conditions are met
-    Tournament tournament = database->getTournamentById(tournamentId);
     if (tournament.getPairingSystem() == "swiss" && tournament.getStatus() == Tournament::Active)
     {
         // Check if we can add another round:
@@ -1850,18 +2152,18 @@ int MainWindow::getCurrentTournamentId()
         return tournamentSelector->itemData(currentIndex).toInt();
     }
 
-    // If no tournament is selected, get all tournaments
-    QList<Tournament> tournaments = database->getAllTournaments();
+    // If no tournament is selected, look up the newest one
+    QList<TournamentCatalogEntry> catalog = database->getTournamentCatalog(1);
 
     // If there are no tournaments, create a new one
-    if (tournaments.isEmpty())
+    if (catalog.isEmpty())
     {
         int tournamentId = database->addTournament("Default Tournament");
         return tournamentId;
     }
 
     // Return the ID of the first tournament
-    return tournaments.first().getId();
+    return catalog.first().id;
 }
 
 void MainWindow::closeEvent(QCloseEvent *event)
@@ -2044,12 +2346,57 @@ void MainWindow::showSettingsDialog()
     QCheckBox *autoStartCheckbox = new QCheckBox("Auto-start tournament when enough players are added", &settingsDialog);
     autoStartCheckbox->setChecked(settings->getAutoStartTournament());
 
+    // Create storage group box
+    QGroupBox *storageGroupBox = new QGroupBox("Storage", &settingsDialog);
+    QVBoxLayout *storageLayout = new QVBoxLayout(storageGroupBox);
+
+    QCheckBox *inMemoryCheckbox = new QCheckBox("Keep the working database in memory (applied after restart)", storageGroupBox);
+    inMemoryCheckbox->setChecked(settings->getInMemoryDatabase());
+    inMemoryCheckbox->setToolTip("Results are saved instantly in memory and written to disk in the background. "
+                                 "A crash loses at most one save interval of changes.");
+
+    QSpinBox *persistIntervalSpinBox = new QSpinBox(storageGroupBox);
+    persistIntervalSpinBox->setRange(1, 600);
+    persistIntervalSpinBox->setValue(settings->getPersistIntervalSeconds());
+    persistIntervalSpinBox->setPrefix("Save to disk every ");
+    persistIntervalSpinBox->setSuffix(" s");
+    persistIntervalSpinBox->setEnabled(inMemoryCheckbox->isChecked());
+
+    connect(inMemoryCheckbox, &QCheckBox::toggled, persistIntervalSpinBox, &QSpinBox::setEnabled);
+
+    QSpinBox *backupIntervalSpinBox = new QSpinBox(storageGroupBox);
+    backupIntervalSpinBox->setRange(0, 24 * 60);
+    backupIntervalSpinBox->setValue(settings->getBackupIntervalMinutes());
+    backupIntervalSpinBox->setPrefix("Back up every ");
+    backupIntervalSpinBox->setSuffix(" min");
+    backupIntervalSpinBox->setSpecialValueText("No scheduled backups");
+
+    QSpinBox *backupKeepSpinBox = new QSpinBox(storageGroupBox);
+    backupKeepSpinBox->setRange(1, 100);
+    backupKeepSpinBox->setValue(settings->getBackupKeepCount());
+    backupKeepSpinBox->setPrefix("Keep ");
+    backupKeepSpinBox->setSuffix(" backups");
+
+    QSpinBox *maintenanceIdleSpinBox = new QSpinBox(storageGroupBox);
+    maintenanceIdleSpinBox->setRange(0, 24 * 60);
+    maintenanceIdleSpinBox->setValue(settings->getMaintenanceIdleMinutes());
+    maintenanceIdleSpinBox->setPrefix("Maintain after ");
+    maintenanceIdleSpinBox->setSuffix(" idle min");
+    maintenanceIdleSpinBox->setSpecialValueText("No idle maintenance");
+
+    storageLayout->addWidget(inMemoryCheckbox);
+    storageLayout->addWidget(persistIntervalSpinBox);
+    storageLayout->addWidget(backupIntervalSpinBox);
+    storageLayout->addWidget(backupKeepSpinBox);
+    storageLayout->addWidget(maintenanceIdleSpinBox);
+
     // Add widgets to main layout
     layout->addWidget(pairingGroupBox);
     layout->addWidget(tiebreakerGroupBox);
     layout->addWidget(themeGroupBox);
     layout->addWidget(iconGroupBox);
     layout->addWidget(autoStartCheckbox);
+    layout->addWidget(storageGroupBox);
     layout->addStretch();
 
     // Create buttons
@@ -2122,6 +2469,15 @@ void MainWindow::showSettingsDialog()
 
         settings->setAutoStartTournament(autoStartCheckbox->isChecked());
 
+        // Update storage settings
+        settings->setInMemoryDatabase(inMemoryCheckbox->isChecked());
+        settings->setPersistIntervalSeconds(persistIntervalSpinBox->value());
+        settings->setBackupIntervalMinutes(backupIntervalSpinBox->value());
+        settings->setBackupKeepCount(backupKeepSpinBox->value());
+        backupManager->setSchedule(settings->getBackupIntervalMinutes(), settings->getBackupKeepCount());
+        settings->setMaintenanceIdleMinutes(maintenanceIdleSpinBox->value());
+        maintenanceScheduler->setIdleMinutes(settings->getMaintenanceIdleMinutes());
+
         // Save settings
         settings->save();
 
@@ -2171,6 +2527,7 @@ void MainWindow::onAddTournamentClicked()
 
 void MainWindow::onTournamentSelectionChanged(int index)
 {
+    OT_TRACE_SCOPE("MainWindow::onTournamentSelectionChanged");
     // Get selected tournament ID
     int tournamentId = tournamentSelector->itemData(index).toInt();
 
@@ -2180,6 +2537,13 @@ void MainWindow::onTournamentSelectionChanged(int index)
 
     // Update tournament status in UI
     Tournament tournament = database->getTournamentById(tournamentId);
+    updateTournamentControls(tournament);
+
+    mainStatusBar->showMessage(QString("Selected tournament: %1").arg(tournament.getName()));
+}
+
+void MainWindow::updateTournamentControls(const Tournament &tournament)
+{
     if (tournament.getStatus() == Tournament::Active)
     {
         endTournamentButton->setEnabled(true);
@@ -2198,8 +2562,6 @@ void MainWindow::onTournamentSelectionChanged(int index)
         addPlayerButton->setEnabled(true);
         resetTournamentButton->setEnabled(true);
     }
-
-    mainStatusBar->showMessage(QString("Selected tournament: %1").arg(tournament.getName()));
 }
 
 void MainWindow::onTournamentContextMenuRequested(const QPoint &pos)
@@ -2213,8 +2575,7 @@ void MainWindow::onTournamentContextMenuRequested(const QPoint &pos)
     int tournamentId = tournamentSelector->itemData(index).toInt();
 
     // Don't allow editing/deleting the last tournament
-    QList<Tournament> tournaments = database->getAllTournaments();
-    if (tournaments.size() <= 1)
+    if (database->getTournamentCount() <= 1)
     {
         QMessageBox::information(this, "Cannot Modify Tournament",
                                  "You cannot edit or delete the last tournament. At least one tournament must exist.");
@@ -2266,10 +2627,10 @@ void MainWindow::onEditTournamentClicked()
     if (ok && !newName.isEmpty() && newName != currentName)
     {
         // Check if new name already exists
-        QList<Tournament> tournaments = database->getAllTournaments();
-        for (const Tournament &t : tournaments)
+        QList<TournamentCatalogEntry> catalog = database->getTournamentCatalog();
+        for (const TournamentCatalogEntry &entry : catalog)
         {
-            if (t.getId() != tournamentId && t.getName() == newName)
+            if (entry.id != tournamentId && entry.name == newName)
             {
                 QMessageBox::warning(this, "Duplicate Tournament",
                                      "A tournament with this name already exists.");
@@ -2349,20 +2710,21 @@ void MainWindow::onDeleteTournamentClicked()
 
 void MainWindow::populateTournamentSelector()
 {
+    OT_TRACE_SCOPE("MainWindow::populateTournamentSelector");
     // Clear existing items
     tournamentSelector->clear();
 
-    // Get all tournaments from database
-    QList<Tournament> tournaments = database->getAllTournaments();
+    // Get the tournament catalog from database
+    QList<TournamentCatalogEntry> catalog = database->getTournamentCatalog();
 
     // Add tournaments to selector
-    for (const Tournament &tournament : tournaments)
+    for (const TournamentCatalogEntry &entry : catalog)
     {
-        tournamentSelector->addItem(tournament.getName(), tournament.getId());
+        tournamentSelector->addItem(entry.name, entry.id);
     }
 
     // Select the first tournament if any exist
-    if (!tournaments.isEmpty())
+    if (!catalog.isEmpty())
     {
         tournamentSelector->setCurrentIndex(0);
     }
@@ -17,6 +17,12 @@
 #include <QComboBox>
 #include <QDesktopServices>
 #include <QUrl>
+#include <QLineEdit>
+#include <QLabel>
+#include <QHash>
+#include <QFutureWatcher>
+#include <QPaintEvent>
+#include <QElapsedTimer>
 
 #include "Database.h"
 #include "Player.h"
@@ -24,6 +30,15 @@
 #include "Tournament.h"
 #include "Settings.h"
 #include "Tiebreaker.h"
+#include "Standings.h"
+#include "StandingsCalculator.h"
+#include "BatchEntry.h"
+#include "AsyncDatabase.h"
+#include "ReadPool.h"
+#include "InMemoryDatabase.h"
+#include "BackupManager.h"
+#include "MaintenanceScheduler.h"
+#include "PlayerIndex.h"
 
 class QApplication; // Forward declaration
 
@@ -39,6 +54,9 @@ private slots:
     void onAddPlayerClicked();
     void onResetTournamentClicked();
     void onExportResultsClicked();
+    void onBackupNowClicked();
+    void onRestoreBackupClicked();
+    void onImportRosterClicked();
     void onMatchResultClicked();
     void onEditMatchClicked();
     void onPlayerSelectionChanged();
@@ -54,6 +72,20 @@ private slots:
     void onEditTournamentClicked();                           // New slot for editing tournament
     void onDeleteTournamentClicked();                         // New slot for deleting tournament
     void onAddSwissRoundClicked();                            // New slot for adding Swiss round
+    void onStandingsReady(const StandingsResult &result, StandingsCalculator::Purpose purpose);
+    void onStandingsFailed(int tournamentId, StandingsCalculator::Purpose purpose);
+    void onStartupSnapshotLoaded();
+    void onPerformanceHudToggled(bool checked);
+
+    // Batch result entry slots
+    void onBatchModeToggled(bool enabled);
+    void onBatchEntrySubmitted();
+    void onCommitBatchClicked();
+    void onDiscardBatchClicked();
+
+    // Player search slots
+    void onPlayerSearchTextChanged(const QString &text);
+    void onPlayerSearchNext();
 
     // Theme and icon slots
     void onFusionDarkSelected();
@@ -72,12 +104,19 @@ private:
     QTabWidget *roundTabs;
     QStatusBar *mainStatusBar;
     QComboBox *tournamentSelector; // New tournament selector
+    QLineEdit *playerSearchEdit;   // Jumps to a player's board and standings row
 
     // Actions
     QAction *exportResultsAction;
+    QAction *backupNowAction;
+    QAction *restoreBackupAction;
+    QAction *importRosterAction;
     QAction *exitAction;
     QAction *aboutAction;
+    QAction *diagnosticsAction;
     QAction *settingsAction; // New settings action
+    QAction *performanceHudAction;
+    QAction *batchModeAction; // Toggles keyboard-driven batch result entry
 
     // Theme actions
     QAction *fusionDarkAction;
@@ -97,9 +136,46 @@ private:
     QPushButton *tiebreakerButton;      // New tiebreaker button
     QPushButton *addTournamentButton;   // New add tournament button
 
+    // Batch result entry
+    QToolBar *batchToolBar;
+    QLineEdit *batchEntryEdit;
+    QLabel *batchStatusLabel;
+    QPushButton *commitBatchButton;
+    QPushButton *discardBatchButton;
+
     // Data managers
     Database *database;
     Settings *settings; // New settings manager
+    StandingsCalculator *standingsCalculator; // Computes standings off the GUI thread
+    BatchEntry *batchEntry;                   // Results staged during batch entry
+    AsyncDatabase *asyncDatabase;             // Writes results off the GUI thread
+    ReadPool *readPool;                       // Read-only connections for worker threads
+    InMemoryDatabase *inMemoryDatabase;       // In-memory working copy, or nullptr when disabled
+    BackupManager *backupManager;             // Scheduled hot backups of the live database
+    MaintenanceScheduler *maintenanceScheduler; // Database upkeep while the user is idle
+    bool inMemoryUnavailable;                 // In-memory mode is on but the catalog is split
+    bool batchCommitPending;                  // Staged results are being written by asyncDatabase
+
+    // Player search state, rebuilt with every standings snapshot
+    PlayerIndex playerIndex;
+    QHash<int, int> standingsRowByPlayer;     // Player ID → row in playerTable
+    QHash<int, int> currentRoundRowByPlayer;  // Player ID → row in the current round's table
+    int currentRoundTabIndex;                 // Tab index of the current (latest) round
+    QList<int> searchResults;
+    int searchResultPosition;
+
+    // Performance HUD
+    QLabel *performanceLabel;
+    QElapsedTimer refreshTimer;
+    qint64 refreshQueryBaseline;
+    qint64 refreshRowBaseline;
+    int cellsRebuilt;
+    qint64 lastStandingsMs;
+
+    // Deferred startup
+    QFutureWatcher<StartupSnapshot> *startupWatcher;
+    bool firstFramePainted;
+    bool startupLoaded;
 
     // Application reference for theme changes
     QApplication *app;
@@ -108,6 +184,7 @@ private:
     void setupUI();
     void setupMenu();
     void setupToolbar();
+    void setupBatchToolbar();
     void setupPlayerPanel();
     void setupMatchPanel();
     void updatePlayerList();
@@ -123,6 +200,22 @@ private:
     void calculateAndDisplayTiebreakers(); // New method for calculating tiebreakers
     void showTiebreakerSettingsDialog();   // New method for showing tiebreaker settings dialog
     void populateTournamentSelector();     // New method for populating tournament selector
+    void showDiagnosticsDialog();
+    void beginRefreshMeasurement();
+    void finishRefreshMeasurement();
+    StandingsSnapshot createStandingsSnapshot(int tournamentId, bool computeTiebreakers);
+    StandingsSnapshot createStandingsSnapshot(int tournamentId, const QList<Player> &players,
+                                              const QList<Match> &matches, bool computeTiebreakers);
+    void applyStartupSnapshot(const StartupSnapshot &snapshot);
+    void updateTournamentControls(const Tournament &tournament);
+    void buildMatchTabs(const Tournament &tournament, const QList<Match> &matches, const QHash<int, QString> &playerNames);
+    void displayStandings(const QList<PlayerStanding> &standings);
+    void finishTournament(const StandingsResult &result);
+    void restoreStagedResults();
+    void updateBatchStatus();
+    void finishBatchCommit(int tournamentId, const QMap<int, QString> &results, int committedCount,
+                           const QList<int> &skipped);
+    void jumpToPlayer(int playerId);
 
     // Theme and icon methods
     void setDefaultIcons();
@@ -130,6 +223,8 @@ private:
 
     // Event handlers
     void closeEvent(QCloseEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override; // Reports input to maintenanceScheduler
 
     // Helper methods
     int getCurrentTournamentId();
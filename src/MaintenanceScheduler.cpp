@@ -0,0 +1,103 @@
+#include "MaintenanceScheduler.h"
+#include <QMutexLocker>
+#include <QDebug>
+#include "Database.h"
+#include "Trace.h"
+
+MaintenanceScheduler::MaintenanceScheduler(const QString &databasePath, QObject *parent)
+    : QThread(parent), databasePath(databasePath.isEmpty() ? Database::defaultDatabasePath() : databasePath),
+      idleDeadline(QDeadlineTimer::Forever), idleMinutes(0), workLeft(false), stopping(false)
+{
+    // Each instance needs its own connection name
+    static QAtomicInt nextInstance;
+    connectionName = QString("maintenance_%1").arg(nextInstance.fetchAndAddRelaxed(1));
+}
+
+MaintenanceScheduler::~MaintenanceScheduler()
+{
+    stop();
+}
+
+void MaintenanceScheduler::setIdleMinutes(int idleMinutes)
+{
+    QMutexLocker locker(&mutex);
+    this->idleMinutes = idleMinutes;
+    idleDeadline = idleMinutes > 0 ? QDeadlineTimer(qint64(idleMinutes) * 60 * 1000)
+                                   : QDeadlineTimer(QDeadlineTimer::Forever);
+    stateChanged.wakeAll();
+}
+
+void MaintenanceScheduler::userActive()
+{
+    // Set under the mutex, so a slice cannot start between the two
+    QMutexLocker locker(&mutex);
+    if (idleMinutes > 0)
+    {
+        idleDeadline = QDeadlineTimer(qint64(idleMinutes) * 60 * 1000);
+    }
+    canceled.storeRelaxed(1);
+}
+
+void MaintenanceScheduler::stop()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopping = true;
+        canceled.storeRelaxed(1);
+        stateChanged.wakeAll();
+    }
+
+    wait();
+}
+
+bool MaintenanceScheduler::isDue() const
+{
+    return idleMinutes > 0 && idleDeadline.hasExpired() && (workLeft || nextRun.hasExpired());
+}
+
+void MaintenanceScheduler::run()
+{
+    Database database(databasePath, connectionName);
+    if (!database.open())
+    {
+        qDebug() << "Maintenance disabled, cannot open" << databasePath;
+        return;
+    }
+
+    forever
+    {
+        {
+            QMutexLocker locker(&mutex);
+            while (!stopping && !isDue())
+            {
+                // Activity only ever moves the idle deadline later, so waking
+                // early just means waiting again
+                QDeadlineTimer wake = idleMinutes <= 0 ? QDeadlineTimer(QDeadlineTimer::Forever)
+                                      : workLeft       ? idleDeadline
+                                                       : qMax(idleDeadline, nextRun);
+                stateChanged.wait(&mutex, wake);
+            }
+            if (stopping)
+            {
+                break;
+            }
+            canceled.storeRelaxed(0);
+        }
+
+        OT_TRACE_SCOPE("MaintenanceScheduler::slice");
+        MaintenanceReport report = database.runMaintenance(SliceBudgetMs, [this]()
+                                                           { return canceled.loadRelaxed() != 0; });
+
+        QMutexLocker locker(&mutex);
+        workLeft = report.ok && !report.finished;
+        if (!workLeft)
+        {
+            nextRun = QDeadlineTimer(qint64(MinimumIntervalMinutes) * 60 * 1000);
+        }
+        else if (idleDeadline.hasExpired())
+        {
+            // Still idle; let other connections in before the next slice
+            idleDeadline = QDeadlineTimer(SlicePauseMs);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef MAINTENANCESCHEDULER_H
+#define MAINTENANCESCHEDULER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QDeadlineTimer>
+#include <QAtomicInt>
+#include <QString>
+
+// Runs Database::runMaintenance() on a dedicated thread with its own
+// connection once the user has been inactive for a while. Work is done in
+// slices of SliceBudgetMs; any activity cancels the running slice, and the
+// rest waits for the next idle spell. After a run that finished, the next
+// one waits at least MinimumIntervalMinutes.
+class MaintenanceScheduler : public QThread
+{
+public:
+    explicit MaintenanceScheduler(const QString &databasePath, QObject *parent = nullptr);
+    ~MaintenanceScheduler() override;
+
+    // Run after idleMinutes without activity (0 disables maintenance)
+    void setIdleMinutes(int idleMinutes);
+
+    // Report user activity; cheap enough to call for every input event
+    void userActive();
+
+    // Cancel a run in progress, then stop the worker
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    bool isDue() const; // Call with mutex held
+
+    static const int SliceBudgetMs = 2000;
+    static const int SlicePauseMs = 500;
+    static const int MinimumIntervalMinutes = 60;
+
+    QString databasePath;
+    QString connectionName;
+
+    QMutex mutex;
+    QWaitCondition stateChanged;
+    QAtomicInt canceled; // Set by activity or stop(); polled by the running slice
+    QDeadlineTimer idleDeadline;
+    QDeadlineTimer nextRun;
+    int idleMinutes;
+    bool workLeft; // The last slice ran out of budget before finishing
+    bool stopping;
+};
+
+#endif // MAINTENANCESCHEDULER_H
@@ -43,4 +43,25 @@ private:
     bool locked;
 };
 
+// Plain match row for streaming scans (Database::forEachMatch). The same
+// record is refilled for every row, so nothing is allocated per match.
+struct MatchRecord
+{
+    enum Result
+    {
+        Unplayed,
+        Player1Wins,
+        Player2Wins,
+        Draw
+    };
+
+    int id;
+    int tournamentId;
+    int round;
+    int p1;
+    int p2;
+    Result result;
+    bool locked;
+};
+
 #endif // MATCH_H
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <QtTest/QtTest>
+
+#include "MatchWriteTest.h"
+#include "Database.h"
+
+namespace
+{
+    // The only match of a tournament, as read back from the database
+    Match onlyMatch(Database &database, int tournamentId)
+    {
+        QList<Match> matches = database.getAllMatches(tournamentId);
+        return matches.size() == 1 ? matches.first() : Match();
+    }
+}
+
+void MatchWriteTest::initTestCase()
+{
+    QVERIFY(tempDir.isValid());
+}
+
+void MatchWriteTest::testWritesStayInTheirTournament()
+{
+    // The single-file layout keeps every tournament's matches in one table,
+    // where match ids restart per tournament and collide
+    Database database(tempDir.filePath("scope.db"), "scope");
+    QVERIFY(database.connect());
+
+    int first = database.addTournament("First");
+    int second = database.addTournament("Second");
+    QVERIFY(first > 0 && second > 0);
+    int anna = database.addPlayerToTournament("Anna", first);
+    int boris = database.addPlayerToTournament("Boris", first);
+    QVERIFY(anna > 0 && boris > 0);
+    QVERIFY(database.addPlayerToTournament(anna, second));
+    QVERIFY(database.addPlayerToTournament(boris, second));
+
+    QCOMPARE(database.addMatch(first, 1, anna, boris), 1);
+    QCOMPARE(database.addMatch(second, 1, anna, boris), 1);
+
+    // Result update
+    Match updated = database.recordResult(first, 1, "p1", false);
+    QCOMPARE(updated.getId(), 1);
+    QCOMPARE(updated.getTournamentId(), first);
+    QCOMPARE(updated.getResult(), QString("p1"));
+    QVERIFY(!onlyMatch(database, second).isPlayed());
+
+    // Lock
+    QVERIFY(database.recordResult(first, 1, "draw").isLocked());
+    QCOMPARE(onlyMatch(database, second).getId(), 1);
+    QVERIFY(!onlyMatch(database, second).isLocked());
+
+    // Unlock
+    QCOMPARE(database.recordResult(second, 1, "p2").getId(), 1);
+    QVERIFY(database.unlockMatch(second, 1));
+    QVERIFY(!onlyMatch(database, second).isLocked());
+    QVERIFY(onlyMatch(database, first).isLocked());
+    QCOMPARE(onlyMatch(database, first).getResult(), QString("draw"));
+
+    // Delete
+    QVERIFY(database.deleteMatch(second, 1));
+    QVERIFY(database.getAllMatches(second).isEmpty());
+    QCOMPARE(onlyMatch(database, first).getId(), 1);
+    QCOMPARE(onlyMatch(database, first).getResult(), QString("draw"));
+
+    // Writes to a match the tournament no longer has touch nothing
+    QCOMPARE(database.recordResult(second, 1, "p1").getId(), 0);
+    QVERIFY(!database.unlockMatch(second, 1));
+    QVERIFY(!database.deleteMatch(second, 1));
+    QVERIFY(onlyMatch(database, first).isLocked());
+}
+
+void MatchWriteTest::testRecordResultSkipsLockedMatch()
+{
+    Database database(tempDir.filePath("locked.db"), "locked");
+    QVERIFY(database.connect());
+
+    int tournamentId = database.addTournament("Locked");
+    QVERIFY(tournamentId > 0);
+    int anna = database.addPlayerToTournament("Anna", tournamentId);
+    int boris = database.addPlayerToTournament("Boris", tournamentId);
+    int matchId = database.addMatch(tournamentId, 1, anna, boris);
+    QVERIFY(matchId > 0);
+
+    QCOMPARE(database.recordResult(tournamentId, matchId, "p1").getId(), matchId);
+
+    // A locked result is final until the match is unlocked
+    QCOMPARE(database.recordResult(tournamentId, matchId, "p2").getId(), 0);
+    QCOMPARE(database.recordResult(tournamentId, matchId, "p2", false).getId(), 0);
+    QCOMPARE(onlyMatch(database, tournamentId).getResult(), QString("p1"));
+    QVERIFY(onlyMatch(database, tournamentId).isLocked());
+
+    QVERIFY(database.unlockMatch(tournamentId, matchId));
+    QCOMPARE(database.recordResult(tournamentId, matchId, "p2").getResult(), QString("p2"));
+}
+
+QTEST_MAIN(MatchWriteTest)
+#include "MatchWriteTest.moc"
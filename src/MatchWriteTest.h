@@ -0,0 +1,20 @@
+#ifndef MATCHWRITETEST_H
+#define MATCHWRITETEST_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class MatchWriteTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testWritesStayInTheirTournament();
+    void testRecordResultSkipsLockedMatch();
+
+private:
+    QTemporaryDir tempDir;
+};
+
+#endif // MATCHWRITETEST_H
@@ -0,0 +1,249 @@
+#include "Pairing.h"
+#include "Database.h"
+#include "Trace.h"
+#include <algorithm>
+#include <vector>
+
+QList<SwissPlayer> Pairing::calculateStandings(const QList<Player> &players, const QList<Match> &matches)
+{
+    OT_TRACE_SCOPE("Pairing::calculateStandings");
+    QList<SwissPlayer> standings;
+
+    // Initialize players with zero stats
+    for (const Player &player : players)
+    {
+        SwissPlayer swissPlayer;
+        swissPlayer.id = player.getId();
+        swissPlayer.name = player.getName();
+        swissPlayer.points = 0.0;
+        swissPlayer.wins = 0;
+        swissPlayer.losses = 0;
+        swissPlayer.draws = 0;
+
+        // Calculate stats from matches
+        for (const Match &match : matches)
+        {
+            if (match.isPlayed())
+            {
+                if (match.getPlayer1Id() == player.getId())
+                {
+                    swissPlayer.opponents.append(match.getPlayer2Id());
+                    if (match.getResult() == "p1")
+                    {
+                        swissPlayer.wins++;
+                        swissPlayer.points += 1.0;
+                    }
+                    else if (match.getResult() == "p2")
+                    {
+                        swissPlayer.losses++;
+                    }
+                    else if (match.getResult() == "draw")
+                    {
+                        swissPlayer.draws++;
+                        swissPlayer.points += 0.5;
+                    }
+                }
+                else if (match.getPlayer2Id() == player.getId())
+                {
+                    swissPlayer.opponents.append(match.getPlayer1Id());
+                    if (match.getResult() == "p2")
+                    {
+                        swissPlayer.wins++;
+                        swissPlayer.points += 1.0;
+                    }
+                    else if (match.getResult() == "p1")
+                    {
+                        swissPlayer.losses++;
+                    }
+                    else if (match.getResult() == "draw")
+                    {
+                        swissPlayer.draws++;
+                        swissPlayer.points += 0.5;
+                    }
+                }
+            }
+        }
+
+        standings.append(swissPlayer);
+    }
+
+    // Sort by points (descending), then by name (ascending)
+    std::sort(standings.begin(), standings.end(), [](const SwissPlayer &a, const SwissPlayer &b)
+              {
+        if (a.points != b.points)
+        {
+            return a.points > b.points;
+        }
+        return a.name < b.name; });
+
+    return standings;
+}
+
+bool Pairing::havePlayed(const SwissPlayer &p1, const SwissPlayer &p2)
+{
+    return p1.opponents.contains(p2.id) || p2.opponents.contains(p1.id);
+}
+
+QList<SwissPair> Pairing::generateSwissRound(QList<SwissPlayer> &players)
+{
+    OT_TRACE_SCOPE("Pairing::generateSwissRound");
+    QList<SwissPair> pairs;
+
+    // Pair players from top to bottom, avoiding rematches
+    for (int i = 0; i < players.size(); ++i)
+    {
+        // Skip if player is already paired
+        if (players[i].id == -1)
+            continue;
+
+        // Look for an opponent who hasn't played this player
+        for (int j = i + 1; j < players.size(); ++j)
+        {
+            // Skip if player is already paired
+            if (players[j].id == -1)
+                continue;
+
+            // Check if they've already played
+            if (!havePlayed(players[i], players[j]))
+            {
+                // Create pair
+                SwissPair pair;
+                pair.p1Id = players[i].id;
+                pair.p2Id = players[j].id;
+                pair.p1Name = players[i].name;
+                pair.p2Name = players[j].name;
+                pairs.append(pair);
+
+                // Mark players as paired
+                players[i].id = -1;
+                players[j].id = -1;
+                break;
+            }
+        }
+    }
+
+    return pairs;
+}
+
+QList<QList<SwissPair>> Pairing::roundRobinPairings(const QList<Player> &players)
+{
+    OT_TRACE_SCOPE("Pairing::roundRobinPairings");
+    // Work on indices into players; -1 stands for the bye
+    std::vector<int> slots;
+    for (int i = 0; i < players.size(); ++i)
+    {
+        slots.push_back(i);
+    }
+
+    int n = static_cast<int>(slots.size());
+    if (n % 2 == 1)
+    {
+        slots.push_back(-1);
+        n++;
+    }
+
+    QList<QList<SwissPair>> rounds;
+    for (int r = 0; r < n - 1; r++)
+    {
+        QList<SwissPair> round;
+        for (int i = 0; i < n / 2; i++)
+        {
+            int p1 = slots[i];
+            int p2 = slots[n - 1 - i];
+            if (p1 != -1 && p2 != -1)
+            {
+                SwissPair pair;
+                pair.p1Id = players[p1].getId();
+                pair.p2Id = players[p2].getId();
+                pair.p1Name = players[p1].getName();
+                pair.p2Name = players[p2].getName();
+                round.append(pair);
+            }
+        }
+        rounds.append(round);
+        // rotate
+        std::rotate(slots.begin() + 1, slots.end() - 1, slots.end());
+    }
+    return rounds;
+}
+
+int Pairing::createRoundRobinSchedule(Database &database, int tournamentId, const QList<Player> &players)
+{
+    OT_TRACE_SCOPE("Pairing::createRoundRobinSchedule");
+    // We need at least 3 players to generate pairings
+    if (players.size() < MinimumPlayers)
+    {
+        return -1;
+    }
+
+    // Generate pairings
+    QList<QList<SwissPair>> pairings = roundRobinPairings(players);
+
+    // Clear existing matches for this tournament
+    database.deleteMatchesForTournament(tournamentId);
+
+    // Reset match ID sequence for this tournament to ensure match IDs start at 1
+    database.resetMatchIdSequence(tournamentId);
+
+    // Create matches in database
+    int created = 0;
+    int roundNumber = 1;
+    for (const QList<SwissPair> &round : pairings)
+    {
+        for (const SwissPair &pair : round)
+        {
+            if (database.addMatch(tournamentId, roundNumber, pair.p1Id, pair.p2Id) == -1)
+            {
+                return -1;
+            }
+            created++;
+        }
+        roundNumber++;
+    }
+
+    return created;
+}
+
+int Pairing::createSwissRound(Database &database, int tournamentId, const QList<Player> &players, int maxRounds)
+{
+    OT_TRACE_SCOPE("Pairing::createSwissRound");
+    // We need at least 3 players to generate pairings
+    if (players.size() < MinimumPlayers)
+    {
+        return -1;
+    }
+
+    QList<Match> matches = database.getAllMatches(tournamentId);
+
+    // Determine the next round number (max existing round + 1)
+    int maxRound = 0;
+    for (const Match &match : matches)
+    {
+        if (match.getRound() > maxRound)
+        {
+            maxRound = match.getRound();
+        }
+    }
+    int currentRound = maxRound + 1;
+
+    // Ensure we don't exceed the maximum number of rounds
+    if (currentRound > maxRounds)
+    {
+        return 0;
+    }
+
+    // Generate pairings for current round from the current standings
+    QList<SwissPlayer> standings = calculateStandings(players, matches);
+    QList<SwissPair> pairs = generateSwissRound(standings);
+
+    // Add new matches to database (without deleting existing ones)
+    for (const SwissPair &pair : pairs)
+    {
+        if (database.addMatch(tournamentId, currentRound, pair.p1Id, pair.p2Id) == -1)
+        {
+            return -1;
+        }
+    }
+
+    return currentRound;
+}
@@ -0,0 +1,59 @@
+#ifndef PAIRING_H
+#define PAIRING_H
+
+#include <QString>
+#include <QList>
+#include "Player.h"
+#include "Match.h"
+
+class Database;
+
+// Structure to hold a player's running score for Swiss pairing
+struct SwissPlayer
+{
+    int id;
+    QString name;
+    double points;
+    int wins;
+    int losses;
+    int draws;
+    QList<int> opponents; // List of opponent IDs
+};
+
+// Structure to hold one pairing produced by either pairing system
+struct SwissPair
+{
+    int p1Id;
+    int p2Id;
+    QString p1Name;
+    QString p2Name;
+};
+
+class Pairing
+{
+public:
+    // Calculate player standings for Swiss pairing
+    static QList<SwissPlayer> calculateStandings(const QList<Player> &players, const QList<Match> &matches);
+
+    // Check if two players have already played against each other
+    static bool havePlayed(const SwissPlayer &p1, const SwissPlayer &p2);
+
+    // Generate Swiss pairings for one round; paired players get their id set to -1
+    static QList<SwissPair> generateSwissRound(QList<SwissPlayer> &players);
+
+    // Generate a full round-robin schedule using the circle method, one list per round
+    static QList<QList<SwissPair>> roundRobinPairings(const QList<Player> &players);
+
+    // Replace the tournament's matches with a round-robin schedule.
+    // Returns the number of matches created, or -1 on failure.
+    static int createRoundRobinSchedule(Database &database, int tournamentId, const QList<Player> &players);
+
+    // Add the next Swiss round to the tournament. Returns the new round number,
+    // 0 once maxRounds has been reached, or -1 on failure.
+    static int createSwissRound(Database &database, int tournamentId, const QList<Player> &players, int maxRounds);
+
+    // Minimum number of players needed to generate pairings
+    static const int MinimumPlayers = 3;
+};
+
+#endif // PAIRING_H
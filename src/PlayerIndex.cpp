@@ -0,0 +1,101 @@
+#include "PlayerIndex.h"
+#include <QStringList>
+#include <QSet>
+#include <algorithm>
+
+PlayerIndex::PlayerIndex() : playerCount(0)
+{
+}
+
+void PlayerIndex::build(const QList<Player> &players)
+{
+    clear();
+    playerCount = players.size();
+    entries.reserve(players.size() * 2);
+
+    for (const Player &player : players)
+    {
+        QString name = player.getName().toCaseFolded();
+        entries.push_back({name, player.getId(), true});
+
+        // Index the remaining words of the name as well
+        QStringList words = name.split(' ', Qt::SkipEmptyParts);
+        for (int i = 1; i < words.size(); ++i)
+        {
+            entries.push_back({words[i], player.getId(), false});
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+              { return a.key < b.key; });
+}
+
+void PlayerIndex::clear()
+{
+    entries.clear();
+    playerCount = 0;
+}
+
+QList<int> PlayerIndex::find(const QString &prefix, int limit) const
+{
+    QList<int> fullNameMatches;
+    QList<int> wordMatches;
+    QString key = prefix.trimmed().toCaseFolded();
+
+    if (key.isEmpty())
+    {
+        return fullNameMatches;
+    }
+
+    // Binary search for the first key that is not less than the prefix
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, [](const Entry &entry, const QString &value)
+                               { return entry.key < value; });
+
+    // A word key can sort before the same player's full name ("anders" before
+    // "anna anders"), so players are only de-duplicated once every hit is
+    // known. Each player has one full-name entry; once limit of those are
+    // found, no word match can make the cut and the scan can stop.
+    QSet<int> fullNameIds;
+    for (; it != entries.end() && it->key.startsWith(key); ++it)
+    {
+        if (it->fullName)
+        {
+            fullNameMatches.append(it->playerId);
+            fullNameIds.insert(it->playerId);
+            if (limit > 0 && fullNameMatches.size() >= limit)
+            {
+                break;
+            }
+        }
+        else
+        {
+            wordMatches.append(it->playerId);
+        }
+    }
+
+    QSet<int> seen = fullNameIds;
+    for (int playerId : std::as_const(wordMatches))
+    {
+        if (limit > 0 && fullNameMatches.size() >= limit)
+        {
+            break;
+        }
+        if (!seen.contains(playerId))
+        {
+            seen.insert(playerId);
+            fullNameMatches.append(playerId);
+        }
+    }
+
+    return fullNameMatches;
+}
+
+bool PlayerIndex::isEmpty() const
+{
+    return entries.empty();
+}
+
+int PlayerIndex::size() const
+{
+    return playerCount;
+}
@@ -0,0 +1,40 @@
+#ifndef PLAYERINDEX_H
+#define PLAYERINDEX_H
+
+#include <QString>
+#include <QList>
+#include <vector>
+#include "Player.h"
+
+// Sorted prefix index over player names. Every word of a name is indexed,
+// so "carl" finds "Magnus Carlsen" as well as "Carla Smith".
+class PlayerIndex
+{
+public:
+    // Constructor
+    PlayerIndex();
+
+    // Rebuild the index from a list of players
+    void build(const QList<Player> &players);
+    void clear();
+
+    // Find players whose name, or any word of it, starts with the given prefix.
+    // Returns player IDs, players matching on their full name first.
+    QList<int> find(const QString &prefix, int limit = 10) const;
+
+    bool isEmpty() const;
+    int size() const;
+
+private:
+    struct Entry
+    {
+        QString key; // Case-folded name or word of a name
+        int playerId;
+        bool fullName;
+    };
+
+    std::vector<Entry> entries; // Sorted by key
+    int playerCount;
+};
+
+#endif // PLAYERINDEX_H
@@ -0,0 +1,157 @@
+#include "QueryStats.h"
+#include <QFile>
+#include <QMutexLocker>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+
+namespace
+{
+    qint64 percentile(std::vector<qint64> samples, double fraction)
+    {
+        if (samples.empty())
+        {
+            return 0;
+        }
+
+        size_t rank = static_cast<size_t>(fraction * (samples.size() - 1) + 0.5);
+        std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+        return samples[rank];
+    }
+}
+
+QueryStats::Handle QueryStats::record(const QString &sql, qint64 durationNs, int rowsAffected)
+{
+    QMutexLocker locker(&mutex);
+    auto it = indexBySql.constFind(sql);
+    int handle;
+    if (it != indexBySql.constEnd())
+    {
+        handle = it.value();
+    }
+    else
+    {
+        handle = static_cast<int>(entries.size());
+        indexBySql.insert(sql, handle);
+        entries.push_back(Entry{sql, 0, 0, 0, 0, {}, 0});
+    }
+
+    Entry &entry = entries[handle];
+    entry.calls++;
+    callCount++;
+    entry.totalNs += durationNs;
+    if (rowsAffected > 0)
+    {
+        entry.rowsAffected += rowsAffected;
+    }
+
+    if (entry.samples.size() < static_cast<size_t>(MaxSamples))
+    {
+        entry.samples.push_back(durationNs);
+    }
+    else
+    {
+        entry.samples[entry.nextSample] = durationNs;
+        entry.nextSample = (entry.nextSample + 1) % MaxSamples;
+    }
+
+    return Handle{handle, generation};
+}
+
+QueryStats::Handle QueryStats::handleFor(const QString &sql) const
+{
+    QMutexLocker locker(&mutex);
+    return Handle{indexBySql.value(sql, -1), generation};
+}
+
+bool QueryStats::addRowsReturned(const Handle &handle, qint64 rows)
+{
+    QMutexLocker locker(&mutex);
+    if (handle.generation != generation || handle.index < 0 || handle.index >= static_cast<int>(entries.size()))
+    {
+        return false;
+    }
+
+    entries[handle.index].rowsReturned += rows;
+    rowsReturnedCount += rows;
+    return true;
+}
+
+QList<QueryStatement> QueryStats::statements() const
+{
+    QMutexLocker locker(&mutex);
+    QList<QueryStatement> result;
+    result.reserve(static_cast<int>(entries.size()));
+    for (const Entry &entry : entries)
+    {
+        QueryStatement statement;
+        statement.sql = entry.sql;
+        statement.calls = entry.calls;
+        statement.totalNs = entry.totalNs;
+        statement.p50Ns = percentile(entry.samples, 0.50);
+        statement.p99Ns = percentile(entry.samples, 0.99);
+        statement.rowsReturned = entry.rowsReturned;
+        statement.rowsAffected = entry.rowsAffected;
+        result.append(statement);
+    }
+
+    std::sort(result.begin(), result.end(), [](const QueryStatement &a, const QueryStatement &b)
+              { return a.totalNs > b.totalNs; });
+
+    return result;
+}
+
+qint64 QueryStats::totalCalls() const
+{
+    QMutexLocker locker(&mutex);
+    return callCount;
+}
+
+qint64 QueryStats::totalRowsReturned() const
+{
+    QMutexLocker locker(&mutex);
+    return rowsReturnedCount;
+}
+
+QByteArray QueryStats::toJson() const
+{
+    QJsonArray array;
+    for (const QueryStatement &statement : statements())
+    {
+        QJsonObject object;
+        object["sql"] = statement.sql.simplified();
+        object["calls"] = statement.calls;
+        object["total_ms"] = statement.totalNs / 1e6;
+        object["p50_ms"] = statement.p50Ns / 1e6;
+        object["p99_ms"] = statement.p99Ns / 1e6;
+        object["rows_returned"] = statement.rowsReturned;
+        object["rows_affected"] = statement.rowsAffected;
+        array.append(object);
+    }
+
+    QJsonObject root;
+    root["statements"] = array;
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+bool QueryStats::writeJson(const QString &filename) const
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    return file.write(toJson()) != -1;
+}
+
+void QueryStats::reset()
+{
+    QMutexLocker locker(&mutex);
+    generation++;
+    entries.clear();
+    indexBySql.clear();
+    callCount = 0;
+    rowsReturnedCount = 0;
+}
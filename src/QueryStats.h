@@ -0,0 +1,83 @@
+#ifndef QUERYSTATS_H
+#define QUERYSTATS_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QByteArray>
+#include <QMutex>
+#include <vector>
+
+// Summary of one SQL statement's executions
+struct QueryStatement
+{
+    QString sql;
+    qint64 calls;
+    qint64 totalNs;
+    qint64 p50Ns;
+    qint64 p99Ns;
+    qint64 rowsReturned;
+    qint64 rowsAffected;
+};
+
+// Per-statement execution statistics for the connections to one database.
+// Statements are keyed by their SQL text, so prepared queries with different
+// bound values are counted together. Every call takes a mutex, so one
+// instance can be shared by connections on several threads.
+class QueryStats
+{
+public:
+    // Refers to one statement until the next reset()
+    struct Handle
+    {
+        int index = -1;
+        quint64 generation = 0;
+    };
+
+    // Record one execution; returns a handle for addRowsReturned()
+    Handle record(const QString &sql, qint64 durationNs, int rowsAffected);
+
+    // Handle of a statement recorded before, or an invalid one
+    Handle handleFor(const QString &sql) const;
+
+    // Count rows fetched from a statement's result set; false if the handle
+    // is invalid or older than the last reset()
+    bool addRowsReturned(const Handle &handle, qint64 rows);
+
+    // Statements sorted by total time, slowest first
+    QList<QueryStatement> statements() const;
+
+    // Running totals across all statements, cheap enough to sample per refresh
+    qint64 totalCalls() const;
+    qint64 totalRowsReturned() const;
+
+    // Statements as a JSON document
+    QByteArray toJson() const;
+    bool writeJson(const QString &filename) const;
+
+    void reset();
+
+private:
+    // Latencies are kept in a ring of recent samples for the percentiles
+    static const int MaxSamples = 1024;
+
+    struct Entry
+    {
+        QString sql;
+        qint64 calls;
+        qint64 totalNs;
+        qint64 rowsReturned;
+        qint64 rowsAffected;
+        std::vector<qint64> samples;
+        int nextSample;
+    };
+
+    mutable QMutex mutex;
+    std::vector<Entry> entries;
+    quint64 generation = 0; // Bumped by reset(), so older handles are refused
+    qint64 callCount = 0;
+    qint64 rowsReturnedCount = 0;
+    QHash<QString, int> indexBySql;
+};
+
+#endif // QUERYSTATS_H
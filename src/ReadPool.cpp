@@ -0,0 +1,39 @@
+#include "ReadPool.h"
+#include <QAtomicInt>
+#include <QDebug>
+
+ReadPool::ReadPool(const QString &databasePath, const std::shared_ptr<QueryStats> &queryStats)
+    : databasePath(databasePath), queryStats(queryStats)
+{
+}
+
+Database *ReadPool::connection()
+{
+    if (!connections.hasLocalData())
+    {
+        // Connection names must be unique across threads and pools
+        static QAtomicInt nextConnection;
+        QString name = QString("read_%1").arg(nextConnection.fetchAndAddRelaxed(1));
+
+        Database *database = new Database(databasePath, name, Database::ReadOnly);
+        if (!database->open())
+        {
+            qDebug() << "Failed to open read-only connection to" << databasePath;
+            delete database;
+            return nullptr;
+        }
+        if (queryStats)
+        {
+            database->setQueryStats(queryStats);
+        }
+
+        connections.setLocalData(database);
+    }
+
+    return connections.localData();
+}
+
+QString ReadPool::getDatabasePath() const
+{
+    return databasePath;
+}
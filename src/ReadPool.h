@@ -0,0 +1,30 @@
+#ifndef READPOOL_H
+#define READPOOL_H
+
+#include <QString>
+#include <QThreadStorage>
+#include "Database.h"
+
+// Hands out read-only connections to the database, one per thread, so worker
+// threads can run exports, standings and reports as WAL readers while the
+// main connection keeps writing. A thread's connection is opened on first use
+// and closed when the thread exits. Every connection counts its statements
+// into the given stats sink, if any.
+class ReadPool
+{
+public:
+    explicit ReadPool(const QString &databasePath,
+                      const std::shared_ptr<QueryStats> &queryStats = std::shared_ptr<QueryStats>());
+
+    // Read-only connection for the calling thread, or nullptr if it cannot be opened
+    Database *connection();
+
+    QString getDatabasePath() const;
+
+private:
+    QString databasePath;
+    std::shared_ptr<QueryStats> queryStats;
+    QThreadStorage<Database *> connections;
+};
+
+#endif // READPOOL_H
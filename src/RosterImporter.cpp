@@ -0,0 +1,106 @@
+#include "RosterImporter.h"
+#include <QStringList>
+
+RosterImporter::RosterImporter(QTextStream &in)
+    : in(in), lineNumber(0), headerChecked(false)
+{
+}
+
+bool RosterImporter::next(RosterEntry &entry)
+{
+    while (!in.atEnd())
+    {
+        ++lineNumber;
+        if (!parseLine(in.readLine(), entry))
+        {
+            continue;
+        }
+
+        // Only the first player line may be a column header
+        if (!headerChecked)
+        {
+            headerChecked = true;
+            if (isHeader(entry))
+            {
+                continue;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+int RosterImporter::getLineNumber() const
+{
+    return lineNumber;
+}
+
+bool RosterImporter::parseLine(const QString &line, RosterEntry &entry)
+{
+    QString text = line.trimmed();
+    if (text.isEmpty() || text.startsWith('#'))
+    {
+        return false;
+    }
+
+    QString name;
+    QString seedText;
+    if (text.startsWith('"'))
+    {
+        // Quoted name: a doubled quote stands for one quote
+        int i = 1;
+        for (; i < text.size(); ++i)
+        {
+            if (text.at(i) == '"')
+            {
+                if (i + 1 < text.size() && text.at(i + 1) == '"')
+                {
+                    name += '"';
+                    ++i;
+                    continue;
+                }
+                break;
+            }
+            name += text.at(i);
+        }
+
+        seedText = text.mid(i + 1).trimmed();
+        if (seedText.startsWith(','))
+        {
+            seedText = seedText.mid(1).trimmed();
+        }
+    }
+    else if (text.contains('\t'))
+    {
+        QStringList fields = text.split('\t');
+        name = fields.at(0);
+        seedText = fields.at(1);
+    }
+    else
+    {
+        // Unquoted CSV: the last field is the seed only if it is a number,
+        // so names like "Carlsen, Magnus" still read as one name
+        int separator = text.lastIndexOf(',');
+        bool hasSeed = false;
+        if (separator != -1)
+        {
+            text.mid(separator + 1).trimmed().toInt(&hasSeed);
+        }
+        name = hasSeed ? text.left(separator) : text;
+        seedText = hasSeed ? text.mid(separator + 1) : QString();
+    }
+
+    entry.name = name.trimmed();
+    entry.seed = seedText.trimmed().toInt(); // 0 when missing or not a number
+    return !entry.name.isEmpty();
+}
+
+bool RosterImporter::isHeader(const RosterEntry &entry)
+{
+    // A "Name,Seed" header has no numeric seed, so it parses as one name
+    QString firstColumn = entry.name.section(',', 0, 0).trimmed();
+    return entry.seed == 0 && (firstColumn.compare("name", Qt::CaseInsensitive) == 0 ||
+                               firstColumn.compare("player", Qt::CaseInsensitive) == 0);
+}
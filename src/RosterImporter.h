@@ -0,0 +1,37 @@
+#ifndef ROSTERIMPORTER_H
+#define ROSTERIMPORTER_H
+
+#include <QString>
+#include <QTextStream>
+#include "Database.h"
+
+// Reads a roster file one player per line: a name and an optional seed,
+// separated by a comma or a tab. Names may be quoted CSV-style. Blank
+// lines, # comments and a leading header row are skipped. Entries are
+// read on demand, so a file can be fed to Database::importRoster()
+// without loading it first.
+class RosterImporter
+{
+public:
+    // Constructor
+    explicit RosterImporter(QTextStream &in);
+
+    // Read the next player; false at the end of the input
+    bool next(RosterEntry &entry);
+
+    // Number of lines read so far
+    int getLineNumber() const;
+
+    // Parse one line; false if it holds no player
+    static bool parseLine(const QString &line, RosterEntry &entry);
+
+private:
+    QTextStream &in;
+    int lineNumber;
+    bool headerChecked;
+
+    // Helper methods
+    static bool isHeader(const RosterEntry &entry);
+};
+
+#endif // ROSTERIMPORTER_H
@@ -0,0 +1,113 @@
+#include <QtTest/QtTest>
+
+#include "RosterImporterTest.h"
+#include "RosterImporter.h"
+#include "Database.h"
+
+void RosterImporterTest::initTestCase()
+{
+    QVERIFY(tempDir.isValid());
+}
+
+void RosterImporterTest::testParseLine_data()
+{
+    QTest::addColumn<QString>("line");
+    QTest::addColumn<bool>("isPlayer");
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<int>("seed");
+
+    QTest::newRow("name only") << "Magnus Carlsen" << true << "Magnus Carlsen" << 0;
+    QTest::newRow("name and seed") << "Magnus Carlsen,2830" << true << "Magnus Carlsen" << 2830;
+    QTest::newRow("surname first") << "Carlsen, Magnus" << true << "Carlsen, Magnus" << 0;
+    QTest::newRow("numeric last field") << "Smith, 12" << true << "Smith" << 12;
+    QTest::newRow("quoted name") << "\"Carlsen, Magnus\",5" << true << "Carlsen, Magnus" << 5;
+    QTest::newRow("doubled quotes") << "\"Bobby \"\"The Kid\"\" Fischer\", 3" << true << "Bobby \"The Kid\" Fischer" << 3;
+    QTest::newRow("tab separated") << "Judit Polgar\t7" << true << "Judit Polgar" << 7;
+    QTest::newRow("tab without seed") << "Judit Polgar\tn/a" << true << "Judit Polgar" << 0;
+    QTest::newRow("surrounding space") << "  Anna Muzychuk , 4  " << true << "Anna Muzychuk" << 4;
+    QTest::newRow("blank") << "   " << false << "" << 0;
+    QTest::newRow("comment") << "# Late entries" << false << "" << 0;
+    QTest::newRow("indented comment") << "  #2830" << false << "" << 0;
+    QTest::newRow("empty quoted name") << "\"\",4" << false << "" << 4;
+}
+
+void RosterImporterTest::testParseLine()
+{
+    QFETCH(QString, line);
+    QFETCH(bool, isPlayer);
+    QFETCH(QString, name);
+    QFETCH(int, seed);
+
+    RosterEntry entry;
+    QCOMPARE(RosterImporter::parseLine(line, entry), isPlayer);
+    if (isPlayer)
+    {
+        QCOMPARE(entry.name, name);
+        QCOMPARE(entry.seed, seed);
+    }
+}
+
+void RosterImporterTest::testHeaderRow_data()
+{
+    QTest::addColumn<QString>("roster");
+    QTest::addColumn<QStringList>("names");
+
+    QTest::newRow("csv header") << "Name,Seed\nAnna,1\nBoris\n" << QStringList{"Anna", "Boris"};
+    QTest::newRow("tab header") << "Player\tRating\nAnna\t1\n" << QStringList{"Anna"};
+    QTest::newRow("header after comments") << "# Club roster\n\nname\nAnna\n" << QStringList{"Anna"};
+    QTest::newRow("no header") << "Anna,1\nBoris,2\n" << QStringList{"Anna", "Boris"};
+    QTest::newRow("header text later") << "Anna\nName\n" << QStringList{"Anna", "Name"};
+    QTest::newRow("seeded header name") << "Name,5\nAnna\n" << QStringList{"Name", "Anna"};
+}
+
+void RosterImporterTest::testHeaderRow()
+{
+    QFETCH(QString, roster);
+    QFETCH(QStringList, names);
+
+    QTextStream in(&roster);
+    RosterImporter importer(in);
+    QStringList read;
+    RosterEntry entry;
+    while (importer.next(entry))
+    {
+        read.append(entry.name);
+    }
+    QCOMPARE(read, names);
+}
+
+void RosterImporterTest::testImportRosterReporting()
+{
+    Database database(tempDir.filePath("roster.db"), "roster");
+    QVERIFY(database.connect());
+
+    int tournamentId = database.addTournament("Roster");
+    QVERIFY(tournamentId > 0);
+    QVERIFY(database.addPlayerToTournament("Anna", tournamentId) > 0); // Already entered
+    QVERIFY(database.addPlayer("Boris") > 0);                          // Registered, not entered
+
+    QString roster = "Name,Seed\nAnna,1\nBoris,2\nCarla,3\nDmitri\nCarla,9\n";
+    QTextStream in(&roster);
+    RosterImporter importer(in);
+    RosterImportResult result = database.importRoster(tournamentId, [&importer](RosterEntry &entry)
+                                                      { return importer.next(entry); });
+
+    QVERIFY(result.ok);
+    QCOMPARE(result.added, 2);
+    QCOMPARE(result.returning, 1);
+    QCOMPARE(result.duplicates, QStringList{"Carla"});
+    QCOMPARE(result.alreadyRegistered, QStringList{"Anna"});
+    QCOMPARE(database.getPlayersForTournament(tournamentId).size(), 4);
+
+    // A duplicate line never overrides the first one's seed
+    for (const Player &player : database.getAllPlayers())
+    {
+        if (player.getName() == "Carla")
+        {
+            QCOMPARE(player.getSeed(), 3);
+        }
+    }
+}
+
+QTEST_MAIN(RosterImporterTest)
+#include "RosterImporterTest.moc"
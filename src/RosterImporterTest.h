@@ -0,0 +1,23 @@
+#ifndef ROSTERIMPORTERTEST_H
+#define ROSTERIMPORTERTEST_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class RosterImporterTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testParseLine_data();
+    void testParseLine();
+    void testHeaderRow_data();
+    void testHeaderRow();
+    void testImportRosterReporting();
+
+private:
+    QTemporaryDir tempDir;
+};
+
+#endif // ROSTERIMPORTERTEST_H
@@ -8,7 +8,9 @@ Settings::Settings()
     : pairingSystem("round_robin"), autoStartTournament(false),
       swissRounds(5), // Default to 5 rounds for Swiss pairing
       theme("abyss"), iconSet("default"),
-      useSeriesTiebreakers(false), singleTiebreaker(0)
+      useSeriesTiebreakers(false), singleTiebreaker(0),
+      showPerformanceHud(false), inMemoryDatabase(false), persistIntervalSeconds(10),
+      backupIntervalMinutes(30), backupKeepCount(10), maintenanceIdleMinutes(5)
 {
 }
 
@@ -94,6 +96,68 @@ void Settings::setSwissRounds(int rounds)
     swissRounds = rounds;
 }
 
+// Diagnostics settings
+bool Settings::getShowPerformanceHud() const
+{
+    return showPerformanceHud;
+}
+
+void Settings::setShowPerformanceHud(bool show)
+{
+    showPerformanceHud = show;
+}
+
+// Storage settings
+bool Settings::getInMemoryDatabase() const
+{
+    return inMemoryDatabase;
+}
+
+int Settings::getPersistIntervalSeconds() const
+{
+    return persistIntervalSeconds;
+}
+
+int Settings::getBackupIntervalMinutes() const
+{
+    return backupIntervalMinutes;
+}
+
+int Settings::getBackupKeepCount() const
+{
+    return backupKeepCount;
+}
+
+int Settings::getMaintenanceIdleMinutes() const
+{
+    return maintenanceIdleMinutes;
+}
+
+void Settings::setInMemoryDatabase(bool inMemory)
+{
+    inMemoryDatabase = inMemory;
+}
+
+void Settings::setPersistIntervalSeconds(int seconds)
+{
+    persistIntervalSeconds = seconds;
+}
+
+void Settings::setBackupIntervalMinutes(int minutes)
+{
+    backupIntervalMinutes = minutes;
+}
+
+void Settings::setBackupKeepCount(int count)
+{
+    backupKeepCount = count;
+}
+
+void Settings::setMaintenanceIdleMinutes(int minutes)
+{
+    maintenanceIdleMinutes = minutes;
+}
+
 bool Settings::load()
 {
     QSettings settings(getSettingsFilePath(), QSettings::IniFormat);
@@ -112,6 +176,16 @@ bool Settings::load()
     singleTiebreaker = settings.value("singleTiebreaker", 0).toInt();
     seriesTiebreakers = settings.value("seriesTiebreakers", QVariant::fromValue(QList<int>())).value<QList<int>>();
 
+    // Load diagnostics settings
+    showPerformanceHud = settings.value("showPerformanceHud", false).toBool();
+
+    // Load storage settings
+    inMemoryDatabase = settings.value("inMemoryDatabase", false).toBool();
+    persistIntervalSeconds = settings.value("persistIntervalSeconds", 10).toInt();
+    backupIntervalMinutes = settings.value("backupIntervalMinutes", 30).toInt();
+    backupKeepCount = settings.value("backupKeepCount", 10).toInt();
+    maintenanceIdleMinutes = settings.value("maintenanceIdleMinutes", 5).toInt();
+
     return true;
 }
 
@@ -133,6 +207,16 @@ bool Settings::save() const
     settings.setValue("singleTiebreaker", singleTiebreaker);
     settings.setValue("seriesTiebreakers", QVariant::fromValue(seriesTiebreakers));
 
+    // Save diagnostics settings
+    settings.setValue("showPerformanceHud", showPerformanceHud);
+
+    // Save storage settings
+    settings.setValue("inMemoryDatabase", inMemoryDatabase);
+    settings.setValue("persistIntervalSeconds", persistIntervalSeconds);
+    settings.setValue("backupIntervalMinutes", backupIntervalMinutes);
+    settings.setValue("backupKeepCount", backupKeepCount);
+    settings.setValue("maintenanceIdleMinutes", maintenanceIdleMinutes);
+
     return true;
 }
 
@@ -25,6 +25,16 @@ public:
     int getSingleTiebreaker() const;
     QList<int> getSeriesTiebreakers() const;
 
+    // Diagnostics settings
+    bool getShowPerformanceHud() const;
+
+    // Storage settings; the in-memory mode is applied at the next start
+    bool getInMemoryDatabase() const;
+    int getPersistIntervalSeconds() const;
+    int getBackupIntervalMinutes() const;
+    int getBackupKeepCount() const;
+    int getMaintenanceIdleMinutes() const;
+
     // Setters
     void setPairingSystem(const QString &system);
     void setAutoStartTournament(bool autoStart);
@@ -39,6 +49,16 @@ public:
     void setSingleTiebreaker(int tiebreaker);
     void setSeriesTiebreakers(const QList<int> &tiebreakers);
 
+    // Diagnostics settings
+    void setShowPerformanceHud(bool show);
+
+    // Storage settings
+    void setInMemoryDatabase(bool inMemory);
+    void setPersistIntervalSeconds(int seconds);
+    void setBackupIntervalMinutes(int minutes);
+    void setBackupKeepCount(int count);
+    void setMaintenanceIdleMinutes(int minutes);
+
     // Load/save settings
     bool load();
     bool save() const;
@@ -57,6 +77,16 @@ private:
     int singleTiebreaker;
     QList<int> seriesTiebreakers;
 
+    // Diagnostics settings
+    bool showPerformanceHud; // Performance readout in the status bar
+
+    // Storage settings
+    bool inMemoryDatabase;      // Work on an in-memory copy of tournament.db
+    int persistIntervalSeconds; // How often the in-memory copy is saved to disk
+    int backupIntervalMinutes;  // Minutes between scheduled backups, 0 for none
+    int backupKeepCount;        // Number of backups kept before the oldest is deleted
+    int maintenanceIdleMinutes; // Idle minutes before database maintenance runs, 0 for never
+
     // Helper methods
     QString getSettingsFilePath() const;
 };
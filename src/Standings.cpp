@@ -0,0 +1,260 @@
+#include "Standings.h"
+#include "Tiebreaker.h"
+#include "Database.h"
+#include "Trace.h"
+#include <QHash>
+#include <algorithm>
+
+namespace
+{
+    // Result of one played match from the point of view of one player
+    struct Encounter
+    {
+        int opponentIndex;
+        double score; // 1.0 for a win, 0.5 for a draw, 0.0 for a loss
+    };
+}
+
+QList<PlayerStanding> Standings::compute(const StandingsSnapshot &snapshot, const std::function<bool()> &isCanceled)
+{
+    OT_TRACE_SCOPE("Standings::compute");
+    auto canceled = [&isCanceled]()
+    { return isCanceled && isCanceled(); };
+
+    // Initialize players with zero stats and index them by ID
+    QList<PlayerStanding> standings;
+    QHash<int, int> indexById;
+    standings.reserve(snapshot.players.size());
+    indexById.reserve(snapshot.players.size());
+    for (const Player &player : snapshot.players)
+    {
+        PlayerStanding standing;
+        standing.playerId = player.getId();
+        standing.playerName = player.getName();
+        standing.points = 0.0;
+        standing.wins = 0;
+        standing.losses = 0;
+        standing.draws = 0;
+        standing.buchholzCutOne = 0.0;
+        standing.sonnebornBerger = 0.0;
+        standing.numberOfWins = 0;
+        standing.cumulativeOpponentScore = 0.0;
+
+        indexById.insert(player.getId(), standings.size());
+        standings.append(standing);
+    }
+
+    // Accumulate points in a single pass over the matches, remembering
+    // who played whom so tiebreakers don't need to rescan the match list
+    QList<QList<Encounter>> encounters(standings.size());
+    int processed = 0;
+    for (const Match &match : snapshot.matches)
+    {
+        if ((++processed % 1024) == 0 && canceled())
+        {
+            return QList<PlayerStanding>();
+        }
+
+        if (!match.isPlayed())
+        {
+            continue;
+        }
+
+        const int p1Index = indexById.value(match.getPlayer1Id(), -1);
+        const int p2Index = indexById.value(match.getPlayer2Id(), -1);
+        const QString result = match.getResult();
+
+        double p1Score = -1.0;
+        if (result == "p1")
+        {
+            p1Score = 1.0;
+        }
+        else if (result == "p2")
+        {
+            p1Score = 0.0;
+        }
+        else if (result == "draw")
+        {
+            p1Score = 0.5;
+        }
+
+        if (p1Score < 0.0)
+        {
+            continue; // Unknown result text
+        }
+
+        if (p1Index != -1)
+        {
+            PlayerStanding &standing = standings[p1Index];
+            if (p1Score == 1.0)
+                standing.wins++;
+            else if (p1Score == 0.0)
+                standing.losses++;
+            else
+                standing.draws++;
+            standing.points += p1Score;
+
+            if (p2Index != -1)
+                encounters[p1Index].append(Encounter{p2Index, p1Score});
+        }
+
+        if (p2Index != -1)
+        {
+            PlayerStanding &standing = standings[p2Index];
+            const double p2Score = 1.0 - p1Score;
+            if (p2Score == 1.0)
+                standing.wins++;
+            else if (p2Score == 0.0)
+                standing.losses++;
+            else
+                standing.draws++;
+            standing.points += p2Score;
+
+            if (p1Index != -1)
+                encounters[p2Index].append(Encounter{p1Index, p2Score});
+        }
+    }
+
+    // Calculate tiebreaker scores from the accumulated points
+    if (snapshot.computeTiebreakers)
+    {
+        QList<double> opponentScores;
+        for (int i = 0; i < standings.size(); ++i)
+        {
+            if (canceled())
+            {
+                return QList<PlayerStanding>();
+            }
+
+            PlayerStanding &standing = standings[i];
+            opponentScores.clear();
+
+            for (const Encounter &encounter : encounters[i])
+            {
+                const double opponentPoints = standings[encounter.opponentIndex].points;
+                opponentScores.append(opponentPoints);
+                standing.cumulativeOpponentScore += opponentPoints;
+                standing.sonnebornBerger += opponentPoints * encounter.score;
+            }
+
+            // Buchholz Cut One: sum of all opponent scores except the lowest one
+            if (!opponentScores.isEmpty())
+            {
+                const double lowest = *std::min_element(opponentScores.begin(), opponentScores.end());
+                standing.buchholzCutOne = standing.cumulativeOpponentScore - lowest;
+            }
+
+            standing.numberOfWins = standing.wins;
+        }
+    }
+
+    if (canceled())
+    {
+        return QList<PlayerStanding>();
+    }
+
+    // Apply the series of tiebreakers, or the single selected one
+    QList<int> tiebreakers;
+    if (snapshot.computeTiebreakers)
+    {
+        if (snapshot.useSeriesTiebreakers)
+            tiebreakers = snapshot.seriesTiebreakers;
+        else
+            tiebreakers.append(snapshot.singleTiebreaker);
+    }
+
+    // Sort by points (descending), then by tiebreakers, then by name
+    std::sort(standings.begin(), standings.end(), [&tiebreakers](const PlayerStanding &a, const PlayerStanding &b)
+              { return rankedBefore(a, b, tiebreakers); });
+
+    return standings;
+}
+
+void Standings::loadSnapshotData(Database &database, StandingsSnapshot &snapshot)
+{
+    snapshot.players = database.getPlayersForTournament(snapshot.tournamentId);
+    snapshot.matches = database.getAllMatches(snapshot.tournamentId);
+    snapshot.loadFromDatabase = false;
+}
+
+bool Standings::hasTies(const QList<PlayerStanding> &standings)
+{
+    QHash<double, int> seen;
+    for (const PlayerStanding &standing : standings)
+    {
+        if (seen.contains(standing.points))
+        {
+            return true;
+        }
+        seen.insert(standing.points, standing.playerId);
+    }
+
+    return false;
+}
+
+void Standings::writeCsv(QTextStream &out, const QList<PlayerStanding> &standings, bool includeTiebreakers)
+{
+    // Write header
+    out << "Player,Points,Wins,Losses,Draws";
+    if (includeTiebreakers)
+    {
+        out << ",Buchholz Cut 1,Sonneborn-Berger,Number of Wins,Cumulative Opponent Score";
+    }
+    out << "\n";
+
+    for (const PlayerStanding &standing : standings)
+    {
+        // Quote the name, doubling any quotes inside it
+        QString name = standing.playerName;
+        name.replace("\"", "\"\"");
+
+        out << "\"" << name << "\","
+            << QString::number(standing.points, 'f', 1) << ","
+            << standing.wins << "," << standing.losses << "," << standing.draws;
+
+        if (includeTiebreakers)
+        {
+            out << "," << QString::number(standing.buchholzCutOne, 'f', 1)
+                << "," << QString::number(standing.sonnebornBerger, 'f', 2)
+                << "," << standing.numberOfWins
+                << "," << QString::number(standing.cumulativeOpponentScore, 'f', 1);
+        }
+        out << "\n";
+    }
+}
+
+bool Standings::rankedBefore(const PlayerStanding &a, const PlayerStanding &b, const QList<int> &tiebreakers)
+{
+    if (a.points != b.points)
+    {
+        return a.points > b.points;
+    }
+
+    for (int tiebreakerType : tiebreakers)
+    {
+        switch (tiebreakerType)
+        {
+        case Tiebreaker::BuchholzCutOne:
+            if (a.buchholzCutOne != b.buchholzCutOne)
+                return a.buchholzCutOne > b.buchholzCutOne;
+            break;
+        case Tiebreaker::SonnebornBerger:
+            if (a.sonnebornBerger != b.sonnebornBerger)
+                return a.sonnebornBerger > b.sonnebornBerger;
+            break;
+        case Tiebreaker::NumberOfWins:
+            if (a.numberOfWins != b.numberOfWins)
+                return a.numberOfWins > b.numberOfWins;
+            break;
+        case Tiebreaker::CumulativeOpponentScore:
+            if (a.cumulativeOpponentScore != b.cumulativeOpponentScore)
+                return a.cumulativeOpponentScore > b.cumulativeOpponentScore;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // If still tied, sort by name
+    return a.playerName < b.playerName;
+}
@@ -0,0 +1,80 @@
+#ifndef STANDINGS_H
+#define STANDINGS_H
+
+#include <QString>
+#include <QList>
+#include <QTextStream>
+#include <functional>
+#include "Player.h"
+#include "Match.h"
+#include "PlayerIndex.h"
+
+// Structure to hold the standing of a single player
+struct PlayerStanding
+{
+    int playerId;
+    QString playerName;
+    double points;
+    int wins;
+    int losses;
+    int draws;
+    double buchholzCutOne;
+    double sonnebornBerger;
+    int numberOfWins;
+    double cumulativeOpponentScore;
+};
+
+// Immutable copy of everything needed to compute standings, so the
+// computation can run on a worker thread without touching the database
+struct StandingsSnapshot
+{
+    int tournamentId = -1;
+    QList<Player> players;
+    QList<Match> matches;
+
+    // When set, players and matches are left empty by the GUI and read by
+    // the worker through a read-only connection instead
+    bool loadFromDatabase = false;
+
+    // Tiebreaker configuration, copied from Settings
+    bool computeTiebreakers = false;
+    bool useSeriesTiebreakers = false;
+    int singleTiebreaker = 0;
+    QList<int> seriesTiebreakers;
+};
+
+// Structure delivered back to the GUI thread once standings are computed
+struct StandingsResult
+{
+    int tournamentId = -1;
+    bool failed = false; // No read connection was available; nothing was computed
+    bool tiebreakersApplied = false;
+    QList<PlayerStanding> standings;
+    PlayerIndex playerIndex; // Search index over the snapshot's players
+    qint64 computeMs = 0;    // Time spent computing on the worker
+};
+
+class Database;
+
+class Standings
+{
+public:
+    // Fill in the snapshot's players and matches from the database
+    static void loadSnapshotData(Database &database, StandingsSnapshot &snapshot);
+
+    // Compute standings sorted by points, then by the configured tiebreakers.
+    // isCanceled is polled while working; an empty list is returned once it fires.
+    static QList<PlayerStanding> compute(const StandingsSnapshot &snapshot,
+                                         const std::function<bool()> &isCanceled = std::function<bool()>());
+
+    // Check if any two players share the same number of points
+    static bool hasTies(const QList<PlayerStanding> &standings);
+
+    // Write standings as CSV, optionally followed by the tiebreaker columns
+    static void writeCsv(QTextStream &out, const QList<PlayerStanding> &standings, bool includeTiebreakers = false);
+
+private:
+    static bool rankedBefore(const PlayerStanding &a, const PlayerStanding &b, const QList<int> &tiebreakers);
+};
+
+#endif // STANDINGS_H
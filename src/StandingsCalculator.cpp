@@ -0,0 +1,128 @@
+#include "StandingsCalculator.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QPromise>
+#include <QElapsedTimer>
+
+StandingsCalculator::StandingsCalculator(QObject *parent)
+    : QObject(parent), readPool(nullptr)
+{
+    for (int i = 0; i < PurposeCount; ++i)
+    {
+        Purpose purpose = static_cast<Purpose>(i);
+        watchers[i] = new QFutureWatcher<StandingsResult>(this);
+        connect(watchers[i], &QFutureWatcher<StandingsResult>::finished, this, [this, purpose]()
+                {
+                    QFuture<StandingsResult> future = watchers[purpose]->future();
+
+                    // Canceled computations never deliver partial standings
+                    if (future.isCanceled() || future.resultCount() == 0)
+                    {
+                        return;
+                    }
+
+                    StandingsResult result = future.result();
+                    if (result.failed)
+                    {
+                        emit standingsFailed(result.tournamentId, purpose);
+                        return;
+                    }
+
+                    emit standingsReady(result, purpose); });
+    }
+}
+
+StandingsCalculator::~StandingsCalculator()
+{
+    cancelAll();
+}
+
+void StandingsCalculator::setReadPool(ReadPool *pool)
+{
+    readPool = pool;
+}
+
+void StandingsCalculator::request(const StandingsSnapshot &snapshot, Purpose purpose)
+{
+    QFutureWatcher<StandingsResult> *watcher = watchers[purpose];
+
+    // Whatever is still running for this purpose is now stale
+    if (watcher->isRunning())
+    {
+        watcher->cancel();
+    }
+
+    QFuture<StandingsResult> future = QtConcurrent::run([purpose, pool = readPool](QPromise<StandingsResult> &promise, StandingsSnapshot snapshot)
+                                                        {
+        QElapsedTimer timer;
+        timer.start();
+
+        StandingsResult result;
+        result.tournamentId = snapshot.tournamentId;
+        result.tiebreakersApplied = snapshot.computeTiebreakers;
+
+        // Read the tournament on this thread so the GUI connection stays free
+        bool storedStandings = false;
+        if (snapshot.loadFromDatabase)
+        {
+            Database *database = pool ? pool->connection() : nullptr;
+            if (!database)
+            {
+                result.failed = true;
+                promise.addResult(result);
+                return;
+            }
+
+            // Without tiebreakers the trigger-maintained totals are the whole
+            // answer; only the leaderboard's search index still needs players
+            if (!snapshot.computeTiebreakers)
+            {
+                result.standings = database->getStandings(snapshot.tournamentId);
+                if (purpose == Leaderboard)
+                {
+                    snapshot.players = database->getPlayersForTournament(snapshot.tournamentId);
+                }
+                storedStandings = true;
+            }
+            else
+            {
+                Standings::loadSnapshotData(*database, snapshot);
+            }
+        }
+
+        if (!storedStandings)
+        {
+            result.standings = Standings::compute(snapshot, [&promise]()
+                                                  { return promise.isCanceled(); });
+        }
+        result.computeMs = timer.elapsed();
+
+        // The leaderboard also gets a fresh player search index
+        if (purpose == Leaderboard)
+        {
+            result.playerIndex.build(snapshot.players);
+        }
+
+        if (!promise.isCanceled())
+        {
+            promise.addResult(result);
+        } }, snapshot);
+
+    // Setting a new future drops any pending signals from the previous one
+    watcher->setFuture(future);
+}
+
+void StandingsCalculator::cancelAll()
+{
+    for (int i = 0; i < PurposeCount; ++i)
+    {
+        if (watchers[i]->isRunning())
+        {
+            watchers[i]->cancel();
+        }
+    }
+}
+
+bool StandingsCalculator::isBusy(Purpose purpose) const
+{
+    return watchers[purpose]->isRunning();
+}
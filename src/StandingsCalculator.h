@@ -0,0 +1,49 @@
+#ifndef STANDINGSCALCULATOR_H
+#define STANDINGSCALCULATOR_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include "Standings.h"
+#include "ReadPool.h"
+
+// Runs standings computation on the global thread pool and delivers the
+// results back on the GUI thread. A new request cancels the in-flight
+// request of the same purpose, since its snapshot has become stale.
+class StandingsCalculator : public QObject
+{
+    Q_OBJECT
+
+public:
+    // What the standings are being computed for
+    enum Purpose
+    {
+        Leaderboard,  // Player table refresh, with or without tiebreakers
+        FinalResults, // Final standings saved when a tournament ends
+        PurposeCount
+    };
+
+    explicit StandingsCalculator(QObject *parent = nullptr);
+    ~StandingsCalculator();
+
+    // Read connections for snapshots marked loadFromDatabase
+    void setReadPool(ReadPool *pool);
+
+    // Start computing standings over the given snapshot
+    void request(const StandingsSnapshot &snapshot, Purpose purpose);
+
+    // Cancel every in-flight computation
+    void cancelAll();
+
+    // Check if a computation is running for the given purpose
+    bool isBusy(Purpose purpose) const;
+
+signals:
+    void standingsReady(const StandingsResult &result, StandingsCalculator::Purpose purpose);
+    void standingsFailed(int tournamentId, StandingsCalculator::Purpose purpose);
+
+private:
+    QFutureWatcher<StandingsResult> *watchers[PurposeCount];
+    ReadPool *readPool;
+};
+
+#endif // STANDINGSCALCULATOR_H
@@ -0,0 +1,117 @@
+#include <QtTest/QtTest>
+#include <QHash>
+
+#include "StandingsTest.h"
+#include "Database.h"
+#include "Standings.h"
+
+void StandingsTest::initTestCase()
+{
+    QVERIFY(tempDir.isValid());
+}
+
+void StandingsTest::verifyStandings(Database &database, int tournamentId, const char *step)
+{
+    StandingsSnapshot snapshot;
+    snapshot.tournamentId = tournamentId;
+    Standings::loadSnapshotData(database, snapshot);
+    QList<PlayerStanding> expected = Standings::compute(snapshot);
+    QList<PlayerStanding> actual = database.getStandings(tournamentId);
+
+    // Players level on points may be listed in either order, so rows are
+    // matched by player and the order is only checked by points
+    QVERIFY2(actual.size() == expected.size(), step);
+    QHash<int, PlayerStanding> expectedById;
+    for (const PlayerStanding &standing : expected)
+    {
+        expectedById.insert(standing.playerId, standing);
+    }
+
+    for (int i = 0; i < actual.size(); ++i)
+    {
+        const PlayerStanding &standing = actual[i];
+        QVERIFY2(expectedById.contains(standing.playerId), step);
+        const PlayerStanding &computed = expectedById.value(standing.playerId);
+        QVERIFY2(standing.playerName == computed.playerName, step);
+        QVERIFY2(standing.points == computed.points, step);
+        QVERIFY2(standing.wins == computed.wins, step);
+        QVERIFY2(standing.losses == computed.losses, step);
+        QVERIFY2(standing.draws == computed.draws, step);
+        QVERIFY2(i == 0 || actual[i - 1].points >= standing.points, step);
+    }
+}
+
+void StandingsTest::testTriggerStandingsMatchCompute_data()
+{
+    QTest::addColumn<bool>("splitLayout");
+
+    QTest::newRow("single file") << false;
+    QTest::newRow("split layout") << true;
+}
+
+void StandingsTest::testTriggerStandingsMatchCompute()
+{
+    QFETCH(bool, splitLayout);
+
+    Database database(tempDir.filePath(QString("standings_%1.db").arg(splitLayout)),
+                      QString("standings_%1").arg(splitLayout));
+    QVERIFY(database.connect());
+    if (splitLayout)
+    {
+        QVERIFY(database.convertToSplitLayout());
+    }
+
+    // A second tournament sharing the players must never leak into the first
+    int tournamentId = database.addTournament("Standings");
+    int otherTournamentId = database.addTournament("Other");
+    QVERIFY(tournamentId > 0 && otherTournamentId > 0);
+
+    QList<int> playerIds;
+    for (const QString &name : {"Anna", "Boris", "Carla", "Dmitri", "Erik", "Fatima"})
+    {
+        int playerId = database.addPlayerToTournament(name, tournamentId);
+        QVERIFY(playerId > 0);
+        QVERIFY(database.addPlayerToTournament(playerId, otherTournamentId));
+        playerIds.append(playerId);
+    }
+    verifyStandings(database, tournamentId, "players entered");
+
+    // Insert: a round with every outcome, one match still unplayed
+    int first = database.addMatch(tournamentId, 1, playerIds[0], playerIds[1]);
+    int second = database.addMatch(tournamentId, 1, playerIds[2], playerIds[3]);
+    int third = database.addMatch(tournamentId, 1, playerIds[4], playerIds[5]);
+    QVERIFY(first > 0 && second > 0 && third > 0);
+    QVERIFY(database.recordResult(tournamentId, first, "p1").getId() == first);
+    QVERIFY(database.recordResult(tournamentId, second, "draw").getId() == second);
+    int other = database.addMatch(otherTournamentId, 1, playerIds[0], playerIds[5]);
+    QVERIFY(other > 0);
+    QVERIFY(database.recordResult(otherTournamentId, other, "p2").getId() == other);
+    verifyStandings(database, tournamentId, "insert");
+
+    // Result update on a match that was never locked
+    QVERIFY(database.recordResult(tournamentId, third, "p2", false).getId() == third);
+    QVERIFY(database.recordResult(tournamentId, third, "p1", false).getId() == third);
+    verifyStandings(database, tournamentId, "result update");
+
+    // Unlock and re-record a locked result
+    QVERIFY(database.unlockMatch(tournamentId, first));
+    QVERIFY(database.recordResult(tournamentId, first, "p2").getId() == first);
+    verifyStandings(database, tournamentId, "unlock and re-record");
+
+    // Match delete
+    int fourth = database.addMatch(tournamentId, 2, playerIds[1], playerIds[2]);
+    QVERIFY(fourth > 0);
+    QVERIFY(database.recordResult(tournamentId, fourth, "draw").getId() == fourth);
+    verifyStandings(database, tournamentId, "second round");
+    QVERIFY(database.deleteMatch(tournamentId, fourth));
+    verifyStandings(database, tournamentId, "match delete");
+
+    // Player removal drops the row; re-adding recounts the player's matches
+    QVERIFY(database.removePlayerFromTournament(playerIds[1], tournamentId));
+    verifyStandings(database, tournamentId, "player removal");
+    QVERIFY(database.addPlayerToTournament(playerIds[1], tournamentId));
+    verifyStandings(database, tournamentId, "player re-add");
+}
+
+QTEST_MAIN(StandingsTest)
+#include "StandingsTest.moc"
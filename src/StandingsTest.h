@@ -0,0 +1,25 @@
+#ifndef STANDINGSTEST_H
+#define STANDINGSTEST_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class Database;
+
+class StandingsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testTriggerStandingsMatchCompute_data();
+    void testTriggerStandingsMatchCompute();
+
+private:
+    // Compare the trigger-maintained standings with a full recomputation
+    void verifyStandings(Database &database, int tournamentId, const char *step);
+
+    QTemporaryDir tempDir;
+};
+
+#endif // STANDINGSTEST_H
@@ -0,0 +1,71 @@
+#include "StartupTimer.h"
+#include <QElapsedTimer>
+#include <QDebug>
+
+namespace
+{
+    QElapsedTimer startupClock;
+}
+
+QList<QPair<QString, qint64>> StartupTimer::milestones;
+QList<QPair<QString, qint64>> StartupTimer::steps;
+bool StartupTimer::reported = false;
+
+void StartupTimer::start()
+{
+    startupClock.start();
+    milestones.clear();
+    steps.clear();
+    reported = false;
+}
+
+void StartupTimer::mark(const QString &label)
+{
+    if (!startupClock.isValid() || reported)
+    {
+        return;
+    }
+
+    milestones.append(qMakePair(label, startupClock.elapsed()));
+}
+
+void StartupTimer::record(const QString &label, qint64 durationMs)
+{
+    if (!startupClock.isValid() || reported)
+    {
+        return;
+    }
+
+    steps.append(qMakePair(label, durationMs));
+}
+
+void StartupTimer::report()
+{
+    if (!startupClock.isValid() || reported)
+    {
+        return;
+    }
+    reported = true;
+
+    qDebug() << "Startup timing breakdown:";
+
+    qint64 previous = 0;
+    for (const auto &milestone : milestones)
+    {
+        qDebug().noquote() << QString("  %1 ms (+%2 ms)  %3")
+                                  .arg(milestone.second, 6)
+                                  .arg(milestone.second - previous, 5)
+                                  .arg(milestone.first);
+        previous = milestone.second;
+    }
+
+    for (const auto &step : steps)
+    {
+        qDebug().noquote() << QString("  worker: %1 ms  %2").arg(step.second, 5).arg(step.first);
+    }
+}
+
+qint64 StartupTimer::elapsed()
+{
+    return startupClock.isValid() ? startupClock.elapsed() : 0;
+}
@@ -0,0 +1,34 @@
+#ifndef STARTUPTIMER_H
+#define STARTUPTIMER_H
+
+#include <QString>
+#include <QList>
+#include <QPair>
+
+// Records named milestones from process start to the first painted frame
+// and a fully loaded tournament, and prints a timing breakdown
+class StartupTimer
+{
+public:
+    // Start timing; called first thing in main()
+    static void start();
+
+    // Record a milestone at the current time
+    static void mark(const QString &label);
+
+    // Record a step measured elsewhere (e.g. on a worker thread)
+    static void record(const QString &label, qint64 durationMs);
+
+    // Print the breakdown once; later calls do nothing
+    static void report();
+
+    // Milliseconds since start()
+    static qint64 elapsed();
+
+private:
+    static QList<QPair<QString, qint64>> milestones;
+    static QList<QPair<QString, qint64>> steps;
+    static bool reported;
+};
+
+#endif // STARTUPTIMER_H
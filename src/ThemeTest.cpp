@@ -78,6 +78,27 @@ void ThemeTest::testSettingsThemePersistence()
     }
 }
 
+void ThemeTest::testSettingsPerformanceHudPersistence()
+{
+    // Test that the performance HUD toggle is saved and loaded
+    Settings settings;
+    settings.load();
+    const bool original = settings.getShowPerformanceHud();
+
+    for (bool show : {true, false}) {
+        settings.setShowPerformanceHud(show);
+        QVERIFY(settings.save());
+
+        Settings loadedSettings;
+        QVERIFY(loadedSettings.load());
+        QCOMPARE(loadedSettings.getShowPerformanceHud(), show);
+    }
+
+    // Restore the user's setting
+    settings.setShowPerformanceHud(original);
+    settings.save();
+}
+
 void ThemeTest::testSettingsFileLocation()
 {
     // Test that the settings file is created in the expected location
@@ -15,6 +15,7 @@ private slots:
     void testDarkHighContrastThemeFileExists();
     void testDarkHighContrastThemeFileReadable();
     void testSettingsThemePersistence();
+    void testSettingsPerformanceHudPersistence();
     void testSettingsFileLocation();
     void testThemeSelection();
     void testApplicationStartupWithTheme();
@@ -0,0 +1,128 @@
+#include "Trace.h"
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QTextStream>
+#include <QDebug>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char *name;
+        int threadId;
+        qint64 startNs;
+        qint64 durationNs;
+    };
+
+    struct TraceState
+    {
+        QString path;
+        QElapsedTimer clock;
+        QMutex mutex;
+        std::vector<TraceEvent> events;
+    };
+
+    // Created once on first use; stays null when tracing is off
+    TraceState *createState()
+    {
+        QString path = qEnvironmentVariable("OT_TRACE");
+        if (path.isEmpty())
+        {
+            return nullptr;
+        }
+
+        TraceState *state = new TraceState;
+        state->path = path;
+        state->events.reserve(1 << 16);
+        state->clock.start();
+        std::atexit(Trace::flush);
+        return state;
+    }
+
+    TraceState *traceState()
+    {
+        static TraceState *state = createState();
+        return state;
+    }
+
+    // Small, stable per-thread ids read better in the viewer than native handles
+    int currentThreadId()
+    {
+        static QAtomicInt nextThreadId;
+        thread_local int threadId = nextThreadId.fetchAndAddRelaxed(1) + 1;
+        return threadId;
+    }
+}
+
+bool Trace::isEnabled()
+{
+    return traceState() != nullptr;
+}
+
+void Trace::record(const char *name, qint64 startNs, qint64 durationNs)
+{
+    TraceState *state = traceState();
+    TraceEvent event = {name, currentThreadId(), startNs, durationNs};
+
+    QMutexLocker locker(&state->mutex);
+    state->events.push_back(event);
+}
+
+void Trace::flush()
+{
+    TraceState *state = traceState();
+    if (!state)
+    {
+        return;
+    }
+
+    QMutexLocker locker(&state->mutex);
+
+    QFile file(state->path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qDebug() << "Failed to write trace file:" << state->path;
+        return;
+    }
+
+    // Complete ("X") events; the viewer nests them by time on each thread
+    QTextStream out(&file);
+    const qint64 pid = QCoreApplication::applicationPid();
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (size_t i = 0; i < state->events.size(); ++i)
+    {
+        const TraceEvent &event = state->events[i];
+        out << (i == 0 ? "" : ",\n")
+            << "{\"name\":\"" << event.name << "\",\"ph\":\"X\""
+            << ",\"ts\":" << QString::number(event.startNs / 1000.0, 'f', 3)
+            << ",\"dur\":" << QString::number(event.durationNs / 1000.0, 'f', 3)
+            << ",\"pid\":" << pid << ",\"tid\":" << event.threadId << "}";
+    }
+    out << "\n]}\n";
+
+    qDebug() << "Trace written to" << state->path << "with" << state->events.size() << "events";
+}
+
+Trace::Scope::Scope(const char *name)
+    : name(name), startNs(-1)
+{
+    if (TraceState *state = traceState())
+    {
+        startNs = state->clock.nsecsElapsed();
+    }
+}
+
+Trace::Scope::~Scope()
+{
+    if (startNs >= 0)
+    {
+        record(name, startNs, traceState()->clock.nsecsElapsed() - startNs);
+    }
+}
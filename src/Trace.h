@@ -0,0 +1,40 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QtGlobal>
+
+// Scoped timers that write Chrome trace-event JSON (chrome://tracing, Perfetto).
+// Off by default; set OT_TRACE to an output path to record a session. Events
+// are kept in memory and written when the process exits.
+class Trace
+{
+public:
+    // Whether OT_TRACE was set when the process started
+    static bool isEnabled();
+
+    // Write the recorded events now; also called automatically at exit
+    static void flush();
+
+    // Times the enclosing scope. The name must outlive the process (a literal).
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name);
+        ~Scope();
+
+    private:
+        Q_DISABLE_COPY(Scope)
+
+        const char *name;
+        qint64 startNs; // -1 when tracing is disabled
+    };
+
+private:
+    static void record(const char *name, qint64 startNs, qint64 durationNs);
+};
+
+#define OT_TRACE_CONCAT_INNER(a, b) a##b
+#define OT_TRACE_CONCAT(a, b) OT_TRACE_CONCAT_INNER(a, b)
+#define OT_TRACE_SCOPE(name) Trace::Scope OT_TRACE_CONCAT(traceScope, __LINE__)(name)
+
+#endif // TRACE_H
@@ -0,0 +1,483 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QMap>
+#include <QRegularExpression>
+#include "Database.h"
+#include "Pairing.h"
+#include "Standings.h"
+#include "Tiebreaker.h"
+#include "BatchEntry.h"
+#include "RosterImporter.h"
+
+// ot-cli: scriptable front end over the same database and engines as the GUI.
+// Every command that writes runs as a single transaction.
+
+namespace
+{
+    QTextStream &out()
+    {
+        static QTextStream stream(stdout);
+        return stream;
+    }
+
+    QTextStream &err()
+    {
+        static QTextStream stream(stderr);
+        return stream;
+    }
+
+    int fail(const QString &message)
+    {
+        err() << "ot-cli: " << message << Qt::endl;
+        return 1;
+    }
+
+    bool readLines(const QString &filename, QStringList &lines)
+    {
+        QFile file(filename);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            return false;
+        }
+
+        QTextStream in(&file);
+        while (!in.atEnd())
+        {
+            // Skip blank lines and comments
+            QString line = in.readLine().trimmed();
+            if (!line.isEmpty() && !line.startsWith('#'))
+            {
+                lines.append(line);
+            }
+        }
+
+        return true;
+    }
+
+    bool parseTournamentId(const QString &text, Database &database, int &tournamentId)
+    {
+        // Commands open transactions of their own, so the tournament's file
+        // is attached up front in the split layout
+        bool ok = false;
+        tournamentId = text.toInt(&ok);
+        return ok && database.getTournamentById(tournamentId).getId() == tournamentId &&
+               database.attachTournament(tournamentId);
+    }
+
+    int createTournament(Database &database, const QStringList &args)
+    {
+        if (args.size() != 1)
+        {
+            return fail("usage: create-tournament <name>");
+        }
+
+        int tournamentId = database.addTournament(args.first());
+        if (tournamentId == -1)
+        {
+            return fail("failed to create tournament");
+        }
+
+        out() << tournamentId << Qt::endl;
+        return 0;
+    }
+
+    int importRoster(Database &database, const QStringList &args)
+    {
+        int tournamentId;
+        if (args.size() != 2 || !parseTournamentId(args.at(0), database, tournamentId))
+        {
+            return fail("usage: import-roster <tournament-id> <file>");
+        }
+
+        // One player per line: name[,seed] or name<TAB>seed
+        QFile file(args.at(1));
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            return fail("cannot read " + args.at(1));
+        }
+
+        QTextStream in(&file);
+        RosterImporter importer(in);
+        RosterImportResult result = database.importRoster(tournamentId, [&importer](RosterEntry &entry)
+                                                          { return importer.next(entry); });
+        if (!result.ok)
+        {
+            return fail("failed to import roster");
+        }
+
+        out() << result.added + result.returning << " players imported (" << result.added << " new, "
+              << result.returning << " returning)" << Qt::endl;
+        for (const QString &name : result.duplicates)
+        {
+            err() << "ot-cli: skipped duplicate line for " << name << Qt::endl;
+        }
+        for (const QString &name : result.alreadyRegistered)
+        {
+            err() << "ot-cli: " << name << " is already in the tournament" << Qt::endl;
+        }
+        return 0;
+    }
+
+    int pairRound(Database &database, const QStringList &args, const QString &system, int maxRounds)
+    {
+        int tournamentId;
+        if (args.size() != 1 || !parseTournamentId(args.at(0), database, tournamentId))
+        {
+            return fail("usage: pair <tournament-id> [--system swiss|round_robin] [--rounds N]");
+        }
+
+        Tournament tournament = database.getTournamentById(tournamentId);
+        QList<Player> players = database.getPlayersForTournament(tournamentId);
+
+        if (tournament.getStatus() == Tournament::Completed)
+        {
+            return fail("tournament is already completed");
+        }
+
+        database.beginTransaction();
+
+        // The first pairing starts the tournament
+        if (tournament.getStatus() == Tournament::Setup)
+        {
+            if (players.size() < Pairing::MinimumPlayers)
+            {
+                database.rollbackTransaction();
+                return fail("at least 3 players are required to start a tournament");
+            }
+
+            tournament.setStatus(Tournament::Active);
+            tournament.setStartedAt(QDateTime::currentDateTime());
+            tournament.setPairingSystem(system.isEmpty() ? tournament.getPairingSystem() : system);
+            if (!database.updateTournament(tournament))
+            {
+                database.rollbackTransaction();
+                return fail("failed to start tournament");
+            }
+
+            if (tournament.getPairingSystem() != "swiss")
+            {
+                int created = Pairing::createRoundRobinSchedule(database, tournamentId, players);
+                if (created == -1)
+                {
+                    database.rollbackTransaction();
+                    return fail("failed to create round-robin schedule");
+                }
+                // A failed commit rolls back by itself
+                if (!database.commitTransaction())
+                {
+                    return fail("failed to save round-robin schedule");
+                }
+
+                out() << created << " matches scheduled" << Qt::endl;
+                return 0;
+            }
+        }
+        else if (tournament.getPairingSystem() != "swiss")
+        {
+            database.rollbackTransaction();
+            return fail("round-robin schedule has already been generated");
+        }
+        else
+        {
+            // Every match of the current round needs a result first; matches
+            // arrive in round order, so only the last round's count survives
+            int maxRound = 0;
+            int unplayed = 0;
+            database.forEachMatch(tournamentId, [&](const MatchRecord &match)
+                                  {
+                if (match.round != maxRound)
+                {
+                    maxRound = match.round;
+                    unplayed = 0;
+                }
+                if (match.result == MatchRecord::Unplayed)
+                {
+                    ++unplayed;
+                }
+                return true; });
+
+            if (unplayed > 0)
+            {
+                database.rollbackTransaction();
+                return fail(QString("round %1 still has matches without results").arg(maxRound));
+            }
+        }
+
+        int round = Pairing::createSwissRound(database, tournamentId, players, maxRounds);
+        if (round == 0)
+        {
+            database.rollbackTransaction();
+            return fail(QString("maximum number of Swiss rounds (%1) reached").arg(maxRounds));
+        }
+        if (round == -1)
+        {
+            database.rollbackTransaction();
+            return fail("failed to create Swiss round");
+        }
+        if (!database.commitTransaction())
+        {
+            return fail("failed to save Swiss round");
+        }
+
+        out() << "round " << round << " paired" << Qt::endl;
+        return 0;
+    }
+
+    int applyResults(Database &database, const QStringList &args)
+    {
+        int tournamentId;
+        if (args.size() != 2 || !parseTournamentId(args.at(0), database, tournamentId))
+        {
+            return fail("usage: apply-results <tournament-id> <file>");
+        }
+
+        // One result per line: <match-id> <p1|p2|draw|1|0|=>, separated by space or comma
+        QStringList lines;
+        if (!readLines(args.at(1), lines))
+        {
+            return fail("cannot read " + args.at(1));
+        }
+
+        QMap<int, QString> results;
+        for (const QString &line : lines)
+        {
+            QStringList fields = line.split(QRegularExpression("[\\s,]+"), Qt::SkipEmptyParts);
+            bool ok = false;
+            int matchId = fields.value(0).toInt(&ok);
+            QString result = fields.value(1);
+
+            if (result.size() == 1)
+            {
+                result = BatchEntry::resultForKey(result.at(0));
+            }
+
+            if (!ok || fields.size() != 2 || (result != "p1" && result != "p2" && result != "draw"))
+            {
+                return fail("invalid result line: " + line);
+            }
+
+            results.insert(matchId, result);
+        }
+
+        QList<int> skipped;
+        int updated = database.commitResults(tournamentId, results, &skipped);
+        if (updated == -1)
+        {
+            return fail("failed to apply results");
+        }
+
+        out() << updated << " results applied" << Qt::endl;
+        for (int matchId : skipped)
+        {
+            err() << "ot-cli: match " << matchId << " was not found or already has a locked result" << Qt::endl;
+        }
+        return 0;
+    }
+
+    int exportStandings(Database &database, const QStringList &args, const QString &outputFile)
+    {
+        int tournamentId;
+        if (args.size() != 1 || !parseTournamentId(args.at(0), database, tournamentId))
+        {
+            return fail("usage: export-standings <tournament-id> [--output file]");
+        }
+
+        StandingsSnapshot snapshot;
+        snapshot.tournamentId = tournamentId;
+        snapshot.players = database.getPlayersForTournament(tournamentId);
+        snapshot.matches = database.getAllMatches(tournamentId);
+        snapshot.computeTiebreakers = true;
+        snapshot.useSeriesTiebreakers = true;
+        snapshot.seriesTiebreakers = {Tiebreaker::BuchholzCutOne, Tiebreaker::SonnebornBerger,
+                                      Tiebreaker::NumberOfWins, Tiebreaker::CumulativeOpponentScore};
+
+        QList<PlayerStanding> standings = Standings::compute(snapshot);
+
+        if (outputFile.isEmpty())
+        {
+            Standings::writeCsv(out(), standings, true);
+            out().flush();
+            return 0;
+        }
+
+        QFile file(outputFile);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            return fail("cannot write " + outputFile);
+        }
+
+        QTextStream stream(&file);
+        Standings::writeCsv(stream, standings, true);
+        return 0;
+    }
+
+    int exportMatches(Database &database, const QStringList &args, const QString &outputFile)
+    {
+        int tournamentId = -1;
+        if (args.size() > 1 || (args.size() == 1 && !parseTournamentId(args.at(0), database, tournamentId)))
+        {
+            return fail("usage: export-matches [tournament-id] [--output file]");
+        }
+
+        QFile file(outputFile);
+        if (!outputFile.isEmpty() && !file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            return fail("cannot write " + outputFile);
+        }
+
+        // Matches are streamed straight to the output, so memory stays flat
+        // however many rows the database holds
+        QTextStream stream(&file);
+        QTextStream &output = outputFile.isEmpty() ? out() : stream;
+        static const char *const results[] = {"", "p1", "p2", "draw"};
+
+        output << "Match ID,Tournament ID,Round,Player 1 ID,Player 2 ID,Result\n";
+        int count = database.forEachMatch(tournamentId, [&output](const MatchRecord &match)
+                                          {
+            output << match.id << ',' << match.tournamentId << ',' << match.round << ','
+                   << match.p1 << ',' << match.p2 << ',' << results[match.result] << '\n';
+            return true; });
+        output.flush();
+
+        if (count == -1)
+        {
+            return fail("failed to read matches");
+        }
+        return 0;
+    }
+
+    int findPlayers(Database &database, const QStringList &args)
+    {
+        if (args.size() != 1)
+        {
+            return fail("usage: find-player <name>");
+        }
+
+        for (const Player &player : database.searchPlayers(args.first(), 20))
+        {
+            out() << player.getId() << "\t" << player.getSeed() << "\t" << player.getName() << "\n";
+        }
+        out().flush();
+        return 0;
+    }
+
+    int splitTournaments(Database &database)
+    {
+        if (database.isSplitLayout())
+        {
+            return fail("tournaments are already in their own files");
+        }
+
+        if (!database.convertToSplitLayout())
+        {
+            return fail("failed to move tournaments into their own files");
+        }
+
+        out() << "tournaments moved to " << database.getTournamentDirectory() << Qt::endl;
+        return 0;
+    }
+
+    int runMaintenance(Database &database, int budgetMs)
+    {
+        MaintenanceReport report = database.runMaintenance(budgetMs);
+        if (!report.ok)
+        {
+            return fail("maintenance failed");
+        }
+
+        const qint64 reclaimed = qint64(report.pagesBefore - report.pagesAfter) * report.pageSize;
+        out() << "steps: " << report.steps.join(", ") << "\n"
+              << "reclaimed: " << reclaimed / 1024 << " KiB in " << report.durationMs << " ms\n"
+              << "free pages left: " << report.freePagesAfter << "\n";
+        if (!report.finished)
+        {
+            out() << "budget exhausted; run again to continue\n";
+        }
+        out().flush();
+        return 0;
+    }
+
+    int listTournaments(Database &database, const QString &status)
+    {
+        for (const TournamentCatalogEntry &entry : database.getTournamentCatalog(-1, 0, status))
+        {
+            Tournament tournament(entry.id, entry.name);
+            tournament.setStatus(entry.status);
+            out() << entry.id << "\t" << tournament.getStatusString() << "\t" << entry.name << "\n";
+        }
+        out().flush();
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ot-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "OpenTournament command-line front end.\n\n"
+        "Commands:\n"
+        "  create-tournament <name>\n"
+        "  import-roster <tournament-id> <file>\n"
+        "  pair <tournament-id>\n"
+        "  apply-results <tournament-id> <file>\n"
+        "  export-standings <tournament-id>\n"
+        "  export-matches [tournament-id]\n"
+        "  find-player <name>\n"
+        "  split-tournaments\n"
+        "  maintain\n"
+        "  list");
+    parser.addHelpOption();
+
+    QCommandLineOption dbOption("db", "Database file (default: tournament.db next to the executable).", "path");
+    QCommandLineOption systemOption("system", "Pairing system for the first pairing: swiss or round_robin.", "system");
+    QCommandLineOption roundsOption("rounds", "Maximum number of Swiss rounds (default 5).", "n", "5");
+    QCommandLineOption outputOption("output", "Write exported standings or matches to a file instead of stdout.", "file");
+    QCommandLineOption statusOption("status", "Only list tournaments with this status.", "status");
+    QCommandLineOption budgetOption("budget", "Time budget for maintain in milliseconds (default 10000).", "ms", "10000");
+    parser.addOptions({dbOption, systemOption, roundsOption, outputOption, statusOption, budgetOption});
+    parser.addPositionalArgument("command", "Command to run.");
+    parser.process(app);
+
+    QStringList args = parser.positionalArguments();
+    if (args.isEmpty())
+    {
+        parser.showHelp(1);
+    }
+
+    QString command = args.takeFirst();
+
+    Database database(parser.value(dbOption));
+    if (!database.connect())
+    {
+        return fail("failed to open database " + database.getDatabasePath());
+    }
+
+    if (command == "create-tournament")
+        return createTournament(database, args);
+    if (command == "import-roster")
+        return importRoster(database, args);
+    if (command == "pair")
+        return pairRound(database, args, parser.value(systemOption), parser.value(roundsOption).toInt());
+    if (command == "apply-results")
+        return applyResults(database, args);
+    if (command == "export-standings")
+        return exportStandings(database, args, parser.value(outputOption));
+    if (command == "export-matches")
+        return exportMatches(database, args, parser.value(outputOption));
+    if (command == "find-player")
+        return findPlayers(database, args);
+    if (command == "split-tournaments")
+        return splitTournaments(database);
+    if (command == "maintain")
+        return runMaintenance(database, parser.value(budgetOption).toInt());
+    if (command == "list")
+        return listTournaments(database, parser.value(statusOption));
+
+    return fail("unknown command " + command);
+}
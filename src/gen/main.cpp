@@ -0,0 +1,242 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QMap>
+#include "Database.h"
+#include "InMemoryDatabase.h"
+#include "Pairing.h"
+#include "Standings.h"
+#include "Tiebreaker.h"
+
+// ot-gen: fills a database with synthetic tournaments through the real
+// Database API, for load-testing. The same seed always produces the same data.
+
+namespace
+{
+    QTextStream &err()
+    {
+        static QTextStream stream(stderr);
+        return stream;
+    }
+
+    int fail(const QString &message)
+    {
+        err() << "ot-gen: " << message << Qt::endl;
+        return 1;
+    }
+
+    // Roughly 40% wins for each side and 20% draws
+    QString randomResult(QRandomGenerator &random)
+    {
+        int roll = random.bounded(5);
+        if (roll < 2)
+            return "p1";
+        if (roll < 4)
+            return "p2";
+        return "draw";
+    }
+
+    bool playRound(Database &database, int tournamentId, int round, QRandomGenerator &random)
+    {
+        QMap<int, QString> results;
+        for (const Match &match : database.getMatchesForRound(tournamentId, round))
+        {
+            results.insert(match.getId(), randomResult(random));
+        }
+
+        return database.commitResults(tournamentId, results) == results.size();
+    }
+
+    bool completeTournament(Database &database, Tournament &tournament)
+    {
+        StandingsSnapshot snapshot;
+        snapshot.tournamentId = tournament.getId();
+        snapshot.players = database.getPlayersForTournament(tournament.getId());
+        snapshot.matches = database.getAllMatches(tournament.getId());
+        snapshot.computeTiebreakers = true;
+        snapshot.useSeriesTiebreakers = true;
+        snapshot.seriesTiebreakers = {Tiebreaker::BuchholzCutOne, Tiebreaker::SonnebornBerger,
+                                      Tiebreaker::NumberOfWins, Tiebreaker::CumulativeOpponentScore};
+
+        // Convert to TournamentResult objects
+        QList<PlayerStanding> standings = Standings::compute(snapshot);
+        QList<TournamentResult> results;
+        for (int i = 0; i < standings.size(); ++i)
+        {
+            const PlayerStanding &stats = standings[i];
+            TournamentResult tournamentResult;
+            tournamentResult.playerId = stats.playerId;
+            tournamentResult.playerName = stats.playerName;
+            tournamentResult.finalRank = i + 1;
+            tournamentResult.points = stats.points;
+            tournamentResult.wins = stats.wins;
+            tournamentResult.losses = stats.losses;
+            tournamentResult.draws = stats.draws;
+            tournamentResult.buchholzCutOne = stats.buchholzCutOne;
+            tournamentResult.sonnebornBerger = stats.sonnebornBerger;
+            tournamentResult.numberOfWins = stats.numberOfWins;
+            tournamentResult.cumulativeOpponentScore = stats.cumulativeOpponentScore;
+            results.append(tournamentResult);
+        }
+
+        if (!database.saveTournamentResults(tournament.getId(), results))
+        {
+            return false;
+        }
+
+        tournament.setStatus(Tournament::Completed);
+        tournament.setCompletedAt(QDateTime::currentDateTime());
+        return database.updateTournament(tournament);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ot-gen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generate synthetic tournaments for load-testing OpenTournament.");
+    parser.addHelpOption();
+
+    QCommandLineOption dbOption("db", "Database file to fill (default: tournament.db next to the executable).", "path");
+    QCommandLineOption tournamentsOption("tournaments", "Number of tournaments (default 10).", "n", "10");
+    QCommandLineOption playersOption("players", "Players per tournament (default 64).", "n", "64");
+    QCommandLineOption roundsOption("rounds", "Rounds to pair and play; 0 plays a full round robin (default 7).", "n", "7");
+    QCommandLineOption systemOption("system", "Pairing system: swiss or round_robin (default swiss).", "system", "swiss");
+    QCommandLineOption seedOption("seed", "Random seed (default 1).", "n", "1");
+    QCommandLineOption activeOption("leave-active", "Leave tournaments active instead of saving final results.");
+    QCommandLineOption memoryOption("in-memory", "Generate in memory and write the file once at the end.");
+    parser.addOptions({dbOption, tournamentsOption, playersOption, roundsOption, systemOption, seedOption, activeOption, memoryOption});
+    parser.process(app);
+
+    const int tournamentCount = parser.value(tournamentsOption).toInt();
+    const int playerCount = parser.value(playersOption).toInt();
+    const int roundCount = parser.value(roundsOption).toInt();
+    const QString system = parser.value(systemOption);
+
+    if (tournamentCount < 1 || playerCount < Pairing::MinimumPlayers || roundCount < 0)
+    {
+        return fail("need at least 1 tournament, 3 players and 0 or more rounds");
+    }
+    if (system != "swiss" && system != "round_robin")
+    {
+        return fail("unknown pairing system " + system);
+    }
+    if (system == "swiss" && roundCount == 0)
+    {
+        return fail("--rounds 0 is only valid for round_robin");
+    }
+
+    // The in-memory copy is written back when it goes out of scope, after database
+    InMemoryDatabase memory(parser.value(dbOption), 60 * 60 * 1000);
+    if (parser.isSet(memoryOption) && !InMemoryDatabase::canHold(parser.value(dbOption)))
+    {
+        return fail("--in-memory needs a database whose tournaments are not in their own files");
+    }
+    if (parser.isSet(memoryOption) && !memory.open())
+    {
+        return fail("failed to load " + memory.getDiskPath() + " into memory");
+    }
+
+    Database database(parser.isSet(memoryOption) ? memory.getDatabasePath() : parser.value(dbOption));
+    if (!database.connect())
+    {
+        return fail("failed to open database " + database.getDatabasePath());
+    }
+
+    QRandomGenerator random(parser.value(seedOption).toUInt());
+    QElapsedTimer timer;
+    timer.start();
+    int totalMatches = 0;
+
+    // Continue numbering after any tournaments already in the file
+    const int firstNumber = database.getTournamentCount() + 1;
+
+    for (int t = 0; t < tournamentCount; ++t)
+    {
+        const int number = firstNumber + t;
+        int tournamentId = database.addTournament(QString("Generated %1").arg(number));
+        if (tournamentId == -1)
+        {
+            return fail("failed to add tournament");
+        }
+
+        // Each tournament is generated in a single transaction; in the split
+        // layout its file has to be attached before that begins
+        if (!database.attachTournament(tournamentId))
+        {
+            database.deleteTournament(tournamentId);
+            return fail("failed to open tournament file");
+        }
+        database.beginTransaction();
+
+        for (int p = 1; p <= playerCount; ++p)
+        {
+            QString name = QString("T%1 Player %2").arg(number).arg(p, 5, 10, QChar('0'));
+            if (database.addPlayerToTournament(name, tournamentId, random.bounded(1000, 2800)) == -1)
+            {
+                database.rollbackTransaction();
+                database.deleteTournament(tournamentId);
+                return fail("failed to add player " + name);
+            }
+        }
+
+        Tournament tournament = database.getTournamentById(tournamentId);
+        tournament.setStatus(Tournament::Active);
+        tournament.setStartedAt(QDateTime::currentDateTime());
+        tournament.setPairingSystem(system);
+        bool ok = database.updateTournament(tournament);
+
+        QList<Player> players = database.getPlayersForTournament(tournamentId);
+
+        if (ok && system == "swiss")
+        {
+            for (int round = 1; ok && round <= roundCount; ++round)
+            {
+                ok = Pairing::createSwissRound(database, tournamentId, players, roundCount) == round &&
+                     playRound(database, tournamentId, round, random);
+            }
+        }
+        else if (ok)
+        {
+            ok = Pairing::createRoundRobinSchedule(database, tournamentId, players) != -1;
+            const int scheduledRounds = playerCount % 2 == 0 ? playerCount - 1 : playerCount;
+            const int playedRounds = roundCount == 0 ? scheduledRounds : qMin(roundCount, scheduledRounds);
+            for (int round = 1; ok && round <= playedRounds; ++round)
+            {
+                ok = playRound(database, tournamentId, round, random);
+            }
+        }
+
+        if (ok && !parser.isSet(activeOption))
+        {
+            ok = completeTournament(database, tournament);
+        }
+
+        if (!ok)
+        {
+            database.rollbackTransaction();
+            database.deleteTournament(tournamentId);
+            return fail(QString("failed to generate tournament %1").arg(number));
+        }
+
+        if (!database.commitTransaction())
+        {
+            return fail("failed to commit tournament");
+        }
+
+        totalMatches += database.forEachMatch(tournamentId, [](const MatchRecord &)
+                                              { return true; });
+        err() << QString("Generated tournament %1/%2 (%3 matches so far, %4 s)")
+                     .arg(t + 1)
+                     .arg(tournamentCount)
+                     .arg(totalMatches)
+                     .arg(timer.elapsed() / 1000.0, 0, 'f', 1)
+              << Qt::endl;
+    }
+
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include <QIcon>
 #include <QDebug>
 #include "MainWindow.h"
+#include "StartupTimer.h"
 
 void setFusionDark(QApplication &app)
 {
@@ -59,9 +60,10 @@ void setFusionWhite(QApplication &app)
 
 int main(int argc, char *argv[])
 {
+    StartupTimer::start();
     qDebug() << "Starting application...";
     QApplication app(argc, argv);
-    qDebug() << "QApplication created";
+    StartupTimer::mark("QApplication created");
 
     // Set application icon
     app.setWindowIcon(QIcon(":/icons/app_icon.png"));
@@ -71,13 +73,14 @@ int main(int argc, char *argv[])
     // For now, we'll use Fusion Dark as default, but in a real implementation
     // we would load the saved theme from settings
     setFusionDark(app); // default theme
-    qDebug() << "Theme set";
+    StartupTimer::mark("Theme set");
 
-    qDebug() << "Creating MainWindow...";
+    // The window only builds its widgets here; the database is opened
+    // and the first tournament loaded on a worker once it is shown
     MainWindow window;
-    qDebug() << "MainWindow created";
+    StartupTimer::mark("MainWindow created");
     window.show();
-    qDebug() << "MainWindow shown";
+    StartupTimer::mark("MainWindow shown");
 
     return app.exec();
 }